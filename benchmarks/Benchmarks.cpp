@@ -0,0 +1,322 @@
+#include "Results.h"
+#include "Workloads.h"
+
+#include <ChipM8/System/Interpreter.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <stdio.h>
+
+/**
+ * Benchmark Options
+ **/
+struct Options{
+    uint32_t frameCycles = 500; // Cycles per 60 Hz frame
+    uint32_t frames = 2000; // Frames per repetition
+    uint32_t warmup = 2; // Repetitions discarded before measuring
+    uint32_t repetitions = 10; // Measured repetitions
+    std::string filter; // Only run workloads containing this
+    std::string jsonPath; // Where to write the results as JSON
+    std::string baselinePath; // Baseline results to compare against
+    double threshold = 10; // Allowed slowdown against the baseline in percent
+    bool fusion = false; // Execute superinstructions
+    bool fusionReport = false; // Report how often each fusion fires
+    bool startupReport = false; // Report how long an Interpreter takes to start
+    std::vector<std::string> roms; // Real ROMs to benchmark
+};
+
+/**
+ * Runs one repetition of a workload
+ *
+ * @return the nanoseconds per executed instruction
+ **/
+static double runRepetition(const Workload &workload, const Options &options){
+    std::unique_ptr<Interpreter> interpreter(new Interpreter());
+    interpreter->loadProgram(workload.program.data(), workload.program.size());
+    interpreter->setCyclesPerTimerTick(workload.cyclesPerTimerTick);
+    interpreter->setFusion(options.fusion);
+
+    uint64_t executed = 0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for(uint32_t frame = 0; frame < options.frames; frame++){
+        executed += interpreter->run(options.frameCycles);
+        interpreter->tickTimers();
+
+        // Keep ROMs waiting for a key press going
+        if(interpreter->hasExecutionHalted()){
+            interpreter->input.setKeyPressed(0x5, true);
+            interpreter->input.setKeyPressed(0x5, false);
+        }
+    }
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+    double nanoseconds = std::chrono::duration<double, std::nano>(end - start).count();
+    return nanoseconds / ((executed == 0)? 1: executed);
+}
+
+static Result runWorkload(const Workload &workload, const Options &options){
+    for(uint32_t repetition = 0; repetition < options.warmup; repetition++){
+        runRepetition(workload, options);
+    }
+
+    std::vector<double> samples;
+    for(uint32_t repetition = 0; repetition < options.repetitions; repetition++){
+        samples.push_back(runRepetition(workload, options));
+    }
+
+    double sum = 0;
+    double minimum = samples[0];
+    for(double sample : samples){
+        sum += sample;
+        minimum = (sample < minimum)? sample: minimum;
+    }
+    double mean = sum / samples.size();
+
+    double squares = 0;
+    for(double sample : samples){
+        squares += (sample - mean) * (sample - mean);
+    }
+    double stddev = (samples.size() > 1)? std::sqrt(squares / (samples.size() - 1)): 0;
+
+    return {workload.name, mean, stddev, minimum, 1e9 / (mean * options.frameCycles), 0};
+}
+
+static const uint32_t STARTUP_ITERATIONS = 10000; // Starts per startup repetition
+
+/**
+ * Times starting an Interpreter, returning the fastest repetition
+ *
+ * @param start - starts an Interpreter, given the iteration
+ * @return the microseconds per start
+ **/
+template<typename Start>
+static double timeStartup(const Options &options, Start start){
+    double fastest = 0;
+    for(uint32_t repetition = 0; repetition < options.warmup + options.repetitions; repetition++){
+        std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+        for(uint32_t iteration = 0; iteration < STARTUP_ITERATIONS; iteration++){
+            start(iteration);
+        }
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+        double microseconds = std::chrono::duration<double, std::micro>(end - begin).count() / STARTUP_ITERATIONS;
+        if(repetition >= options.warmup && (fastest == 0 || microseconds < fastest)){
+            fastest = microseconds;
+        }
+    }
+    return fastest;
+}
+
+/**
+ * Prints how long an Interpreter takes to get ready to run each
+ * workload: constructing one and loading the program, constructing
+ * one and resetting it to a prebuilt image of the program, and
+ * resetting an Interpreter which already ran a frame
+ **/
+static void printStartupReport(const std::vector<Workload> &workloads, const Options &options){
+    printf("%-20s %18s %18s %12s\n", "workload", "construct+load us", "construct+reset us", "reset us");
+    for(const Workload &workload : workloads){
+        if(workload.name.find(options.filter) == std::string::npos){
+            continue;
+        }
+
+        double load = timeStartup(options, [&](uint32_t){
+            std::unique_ptr<Interpreter> interpreter(new Interpreter());
+            interpreter->loadProgram(workload.program.data(), workload.program.size());
+        });
+
+        std::shared_ptr<const MemoryImage> image = Interpreter::createImage(workload.program.data(), workload.program.size());
+        double constructReset = timeStartup(options, [&](uint32_t iteration){
+            std::unique_ptr<Interpreter> interpreter(new Interpreter());
+            interpreter->reset(image, iteration);
+        });
+
+        // Each reset undoes a frame, which is not timed
+        std::unique_ptr<Interpreter> interpreter(new Interpreter());
+        std::chrono::steady_clock::duration resetTime{};
+        for(uint32_t iteration = 0; iteration < STARTUP_ITERATIONS; iteration++){
+            interpreter->run(options.frameCycles);
+            std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+            interpreter->reset(image, iteration);
+            resetTime += std::chrono::steady_clock::now() - begin;
+        }
+        double reset = std::chrono::duration<double, std::micro>(resetTime).count() / STARTUP_ITERATIONS;
+
+        printf("%-20s %18.3f %18.3f %12.3f\n", workload.name.c_str(), load, constructReset, reset);
+    }
+}
+
+/**
+ * Prints how often each fusion fires while running the workloads,
+ * and the share of the executed instructions it covers
+ **/
+static void printFusionReport(const std::vector<Workload> &workloads, const Options &options){
+    printf("%-20s %-14s %12s %14s %8s\n", "workload", "fusion", "fired", "instructions", "share");
+    for(const Workload &workload : workloads){
+        if(workload.name.find(options.filter) == std::string::npos){
+            continue;
+        }
+
+        std::unique_ptr<Interpreter> interpreter(new Interpreter());
+        interpreter->loadProgram(workload.program.data(), workload.program.size());
+        interpreter->setCyclesPerTimerTick(workload.cyclesPerTimerTick);
+        interpreter->setFusion(true);
+
+        uint64_t executed = 0;
+        for(uint32_t frame = 0; frame < options.frames; frame++){
+            executed += interpreter->run(options.frameCycles);
+            interpreter->tickTimers();
+            if(interpreter->hasExecutionHalted()){
+                interpreter->input.setKeyPressed(0x5, true);
+                interpreter->input.setKeyPressed(0x5, false);
+            }
+        }
+
+        for(std::size_t fusion = 0; fusion < (std::size_t) Fusion::COUNT; fusion++){
+            uint64_t fired = interpreter->getFusionCount((Fusion) fusion);
+            uint64_t instructions = interpreter->getFusedInstructionCount((Fusion) fusion);
+            if(fired == 0){
+                continue;
+            }
+            printf("%-20s %-14s %12llu %14llu %7.1f%%\n", workload.name.c_str(), getFusionName((Fusion) fusion),
+                (unsigned long long) fired, (unsigned long long) instructions,
+                100.0 * instructions / ((executed == 0)? 1: executed));
+        }
+    }
+}
+
+static void printUsage(const char *program){
+    std::cerr << "Usage: " << program << " [options] [rom ...]\n"
+        << "  --frame-cycles N   cycles per 60 Hz frame (default 500)\n"
+        << "  --frames N         frames per repetition (default 2000)\n"
+        << "  --warmup N         discarded warmup repetitions (default 2)\n"
+        << "  --repetitions N    measured repetitions (default 10)\n"
+        << "  --filter TEXT      only run workloads whose name contains TEXT\n"
+        << "  --json PATH        write the results as JSON\n"
+        << "  --baseline PATH    compare against baseline JSON, exiting with 2 on a regression\n"
+        << "  --threshold PCT    default allowed slowdown against the baseline (default 10)\n"
+        << "  --fusion           run with superinstructions\n"
+        << "  --fusion-report    report how often each superinstruction fires\n"
+        << "  --startup          report how long starting an Interpreter on each workload takes\n";
+}
+
+static bool parseOptions(int argc, char *argv[], Options &options){
+    for(int arg = 1; arg < argc; arg++){
+        std::string name = argv[arg];
+        bool hasValue = arg + 1 < argc;
+
+        if(name == "--frame-cycles" && hasValue){
+            options.frameCycles = std::strtoul(argv[++arg], nullptr, 10);
+        }else if(name == "--frames" && hasValue){
+            options.frames = std::strtoul(argv[++arg], nullptr, 10);
+        }else if(name == "--warmup" && hasValue){
+            options.warmup = std::strtoul(argv[++arg], nullptr, 10);
+        }else if(name == "--repetitions" && hasValue){
+            options.repetitions = std::strtoul(argv[++arg], nullptr, 10);
+        }else if(name == "--filter" && hasValue){
+            options.filter = argv[++arg];
+        }else if(name == "--json" && hasValue){
+            options.jsonPath = argv[++arg];
+        }else if(name == "--baseline" && hasValue){
+            options.baselinePath = argv[++arg];
+        }else if(name == "--threshold" && hasValue){
+            options.threshold = std::strtod(argv[++arg], nullptr);
+        }else if(name == "--fusion"){
+            options.fusion = true;
+        }else if(name == "--fusion-report"){
+            options.fusionReport = true;
+        }else if(name == "--startup"){
+            options.startupReport = true;
+        }else if(name.compare(0, 2, "--") == 0){
+            return false;
+        }else{
+            options.roms.push_back(name);
+        }
+    }
+    return options.frameCycles > 0 && options.frames > 0 && options.repetitions > 0;
+}
+
+/**
+ * Benchmarks
+ *
+ * Measures the throughput of the Interpreter on synthetic
+ * workloads and on any ROMs given on the command line.
+ *
+ * The results can be written as JSON and compared against a
+ * baseline JSON file, in which case the exit code is 2 if any
+ * benchmark regressed beyond its noise threshold.
+ **/
+int main(int argc, char *argv[]){
+    Options options;
+    if(!parseOptions(argc, argv, options)){
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::vector<Result> baseline;
+    if(!options.baselinePath.empty() && !readResults(options.baselinePath, baseline)){
+        std::cerr << "Could not read baseline " << options.baselinePath << std::endl;
+        return 1;
+    }
+
+    std::vector<Workload> workloads = generateWorkloads(options.frameCycles);
+    for(const std::string &rom : options.roms){
+        Workload workload;
+        if(!loadWorkload(rom, workload)){
+            std::cerr << "Could not read ROM " << rom << std::endl;
+            return 1;
+        }
+        workloads.push_back(workload);
+    }
+
+    std::vector<Result> results;
+    printf("%-20s %12s %10s %12s %14s\n", "workload", "ns/instr", "stddev", "min ns/instr", "frames/s");
+    for(const Workload &workload : workloads){
+        if(workload.name.find(options.filter) == std::string::npos){
+            continue;
+        }
+
+        Result result = runWorkload(workload, options);
+        printf("%-20s %12.3f %10.3f %12.3f %14.0f\n", result.name.c_str(),
+            result.nsPerInstruction, result.stddev, result.minimum, result.framesPerSecond);
+        fflush(stdout);
+        results.push_back(result);
+    }
+
+    if(options.fusionReport){
+        std::cout << std::endl;
+        printFusionReport(workloads, options);
+    }
+
+    if(options.startupReport){
+        std::cout << std::endl;
+        printStartupReport(workloads, options);
+    }
+
+    if(!options.jsonPath.empty()){
+        std::ofstream jsonFile(options.jsonPath);
+        writeResults(jsonFile, options.frameCycles, results);
+        if(!jsonFile.good()){
+            std::cerr << "Could not write " << options.jsonPath << std::endl;
+            return 1;
+        }
+    }
+
+    if(!baseline.empty()){
+        std::cout << std::endl;
+        int regressions = compareResults(std::cout, baseline, results, options.threshold);
+        if(regressions > 0){
+            std::cout << std::endl << regressions << " benchmark(s) regressed" << std::endl;
+            return 2;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,135 @@
+#include "Results.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <map>
+
+#include <stdio.h>
+
+void writeResults(std::ostream &out, uint32_t frameCycles, const std::vector<Result> &results){
+    char line[256];
+
+    out << "{\n";
+    out << "  \"frameCycles\": " << frameCycles << ",\n";
+    out << "  \"benchmarks\": [";
+    for(std::size_t index = 0; index < results.size(); index++){
+        const Result &result = results[index];
+        snprintf(line, sizeof(line),
+            "%s\n    {\"name\": \"%s\", \"nsPerInstruction\": %.4f, \"stddev\": %.4f, \"minimum\": %.4f, \"framesPerSecond\": %.1f}",
+            (index == 0)? "": ",", result.name.c_str(), result.nsPerInstruction, result.stddev, result.minimum, result.framesPerSecond);
+        out << line;
+    }
+    out << "\n  ]\n";
+    out << "}\n";
+}
+
+/**
+ * Reads the value of a "key": value pair within an object
+ **/
+static bool findValue(const std::string &object, const std::string &key, std::string &value){
+    std::size_t position = object.find("\"" + key + "\"");
+    if(position == std::string::npos){
+        return false;
+    }
+
+    position = object.find(':', position);
+    if(position == std::string::npos){
+        return false;
+    }
+    position = object.find_first_not_of(" \t\r\n", position + 1);
+    if(position == std::string::npos){
+        return false;
+    }
+
+    // Strings run to the closing quote, numbers to the next delimiter
+    if(object[position] == '"'){
+        std::size_t end = object.find('"', position + 1);
+        value = object.substr(position + 1, end - position - 1);
+    }else{
+        std::size_t end = object.find_first_of(",} \t\r\n", position);
+        value = object.substr(position, end - position);
+    }
+    return true;
+}
+
+static double findNumber(const std::string &object, const std::string &key){
+    std::string value;
+    return findValue(object, key, value)? std::strtod(value.c_str(), nullptr): 0;
+}
+
+bool readResults(std::string path, std::vector<Result> &results){
+    std::ifstream resultsFile(path);
+    if(!resultsFile.good()){
+        return false;
+    }
+    std::string json((std::istreambuf_iterator<char>(resultsFile)), std::istreambuf_iterator<char>());
+
+    std::size_t position = json.find("\"benchmarks\"");
+    if(position == std::string::npos){
+        return false;
+    }
+
+    // Each benchmark is a flat object within the array
+    results.clear();
+    while((position = json.find('{', position)) != std::string::npos){
+        std::size_t end = json.find('}', position);
+        if(end == std::string::npos){
+            return false;
+        }
+        std::string object = json.substr(position, end - position + 1);
+
+        Result result;
+        if(!findValue(object, "name", result.name)){
+            return false;
+        }
+        result.nsPerInstruction = findNumber(object, "nsPerInstruction");
+        result.stddev = findNumber(object, "stddev");
+        result.minimum = findNumber(object, "minimum");
+        result.framesPerSecond = findNumber(object, "framesPerSecond");
+        result.threshold = findNumber(object, "threshold");
+        results.push_back(result);
+
+        position = end + 1;
+    }
+    return true;
+}
+
+int compareResults(std::ostream &out, const std::vector<Result> &baseline, const std::vector<Result> &results, double threshold){
+    std::map<std::string, const Result *> baselineByName;
+    for(const Result &result : baseline){
+        baselineByName[result.name] = &result;
+    }
+
+    char line[256];
+    snprintf(line, sizeof(line), "%-20s %12s %12s %9s %9s  %s\n", "benchmark", "baseline", "current", "delta", "threshold", "status");
+    out << line;
+
+    int regressions = 0;
+    for(const Result &result : results){
+        std::map<std::string, const Result *>::iterator match = baselineByName.find(result.name);
+        if(match == baselineByName.end()){
+            snprintf(line, sizeof(line), "%-20s %12s %12.3f %9s %9s  %s\n", result.name.c_str(), "-", result.minimum, "-", "-", "new");
+            out << line;
+            continue;
+        }
+
+        const Result &reference = *match->second;
+        double allowed = (reference.threshold > 0)? reference.threshold: threshold;
+        double delta = 100.0 * (result.minimum - reference.minimum) / reference.minimum;
+
+        const char *status = "ok";
+        if(delta > allowed){
+            status = "REGRESSION";
+            regressions++;
+        }else if(delta < -allowed){
+            status = "improved";
+        }
+
+        snprintf(line, sizeof(line), "%-20s %12.3f %12.3f %+8.1f%% %8.1f%%  %s\n",
+            result.name.c_str(), reference.minimum, result.minimum, delta, allowed, status);
+        out << line;
+    }
+
+    return regressions;
+}
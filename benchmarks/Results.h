@@ -0,0 +1,56 @@
+#pragma once
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <stdint.h>
+
+/**
+ * Measurements of one workload
+ **/
+struct Result{
+    std::string name;
+    double nsPerInstruction; // Mean over the repetitions
+    double stddev; // Standard deviation of nsPerInstruction
+    double minimum; // Fastest repetition
+    double framesPerSecond; // Frames emulated per second, from the mean
+    double threshold; // Allowed slowdown in percent, only read from baselines (0 for the default)
+};
+
+/**
+ * Writes results as JSON
+ *
+ * @param out - the stream to write to
+ * @param frameCycles - the cycles per frame the results were measured with
+ * @param results - the results to write
+ **/
+void writeResults(std::ostream &out, uint32_t frameCycles, const std::vector<Result> &results);
+
+/**
+ * Reads results written by writeResults
+ *
+ * Each benchmark in the file may carry its own "threshold"
+ * overriding the default noise threshold.
+ *
+ * @param path - the JSON file to read
+ * @param results - receives the results
+ * @return true if the file could be read
+ **/
+bool readResults(std::string path, std::vector<Result> &results);
+
+/**
+ * Compares results against a baseline
+ *
+ * The fastest repetitions are compared, as they are the least
+ * affected by noise. A benchmark regresses when it is slower
+ * than the baseline by more than its threshold. Prints a table
+ * of the deltas.
+ *
+ * @param out - the stream to print the delta table to
+ * @param baseline - the baseline results
+ * @param results - the current results
+ * @param threshold - the default allowed slowdown in percent
+ * @return the number of regressed benchmarks
+ **/
+int compareResults(std::ostream &out, const std::vector<Result> &baseline, const std::vector<Result> &results, double threshold);
@@ -0,0 +1,125 @@
+#include "Workloads.h"
+
+#include <fstream>
+#include <iterator>
+
+/**
+ * Assembles a program one opcode at a time
+ **/
+struct ProgramBuilder{
+    uint16_t address(){
+        return 0x200 + program.size();
+    }
+
+    void emit(uint16_t opcode){
+        program.push_back((opcode & 0xFF00) >> 8);
+        program.push_back((opcode & 0x00FF) >> 0);
+    }
+
+    void emitData(uint16_t at, const std::vector<uint8_t> &data){
+        program.resize(at - 0x200, 0x00);
+        program.insert(program.end(), data.begin(), data.end());
+    }
+
+    std::vector<uint8_t> program;
+};
+
+static Workload aluWorkload(){
+    ProgramBuilder builder;
+    builder.emit(0x6001);       // STRI V0, 0x01
+    builder.emit(0x6103);       // STRI V1, 0x03
+    uint16_t loop = builder.address();
+    builder.emit(0x8014);       // ADD  V0, V1
+    builder.emit(0x8215);       // SUB  V2, V1
+    builder.emit(0x8311);       // OR   V3, V1
+    builder.emit(0x8402);       // AND  V4, V0
+    builder.emit(0x8503);       // XOR  V5, V0
+    builder.emit(0x8606);       // RSH  V6, V0
+    builder.emit(0x870E);       // LSH  V7, V0
+    builder.emit(0x8817);       // SUBR V8, V1
+    builder.emit(0x7101);       // ADDI V1, 0x01
+    builder.emit(0x1000 | loop); // JUMP loop
+
+    return {"alu", builder.program, 0};
+}
+
+static Workload drawWorkload(uint8_t height){
+    ProgramBuilder builder;
+    builder.emit(0xA300);       // STR  0x300
+    builder.emit(0x6000);       // STRI V0, 0x00
+    builder.emit(0x6100);       // STRI V1, 0x00
+    uint16_t loop = builder.address();
+    builder.emit(0xD010 | height); // DRAW V0, V1, height
+    builder.emit(0x7003);       // ADDI V0, 0x03
+    builder.emit(0x7101);       // ADDI V1, 0x01
+    builder.emit(0x1000 | loop); // JUMP loop
+    builder.emitData(0x300, std::vector<uint8_t>(15, 0xA5));
+
+    return {"draw-" + std::to_string(height), builder.program, 0};
+}
+
+static Workload callWorkload(){
+    ProgramBuilder builder;
+    builder.emit(0x6000);       // 0x200 STRI V0, 0x00
+    builder.emit(0x220A);       // 0x202 EXE  0x20A
+    builder.emit(0x6000);       // 0x204 STRI V0, 0x00
+    builder.emit(0x1202);       // 0x206 JUMP 0x202
+    builder.emit(0x0000);       // 0x208
+    builder.emit(0x7001);       // 0x20A ADDI V0, 0x01
+    builder.emit(0x3010);       // 0x20C SEI  V0, 0x10
+    builder.emit(0x220A);       // 0x20E EXE  0x20A
+    builder.emit(0x00EE);       // 0x210 RET
+
+    return {"call", builder.program, 0};
+}
+
+static Workload memoryWorkload(){
+    ProgramBuilder builder;
+    builder.emit(0xA400);       // STR  0x400
+    uint16_t loop = builder.address();
+    builder.emit(0xFF55);       // STRM VF
+    builder.emit(0xFF65);       // LDM  VF
+    builder.emit(0x7001);       // ADDI V0, 0x01
+    builder.emit(0x1000 | loop); // JUMP loop
+
+    return {"memory", builder.program, 0};
+}
+
+static Workload timerPollWorkload(uint32_t frameCycles){
+    ProgramBuilder builder;
+    builder.emit(0x6002);       // 0x200 STRI V0, 0x02
+    builder.emit(0xF015);       // 0x202 SETD V0
+    builder.emit(0xF107);       // 0x204 STRD V1
+    builder.emit(0x3100);       // 0x206 SEI  V1, 0x00
+    builder.emit(0x1204);       // 0x208 JUMP 0x204
+    builder.emit(0x1200);       // 0x20A JUMP 0x200
+
+    return {"timer-poll", builder.program, frameCycles};
+}
+
+std::vector<Workload> generateWorkloads(uint32_t frameCycles){
+    std::vector<Workload> workloads;
+    workloads.push_back(aluWorkload());
+    for(uint8_t height = 1; height <= 15; height++){
+        workloads.push_back(drawWorkload(height));
+    }
+    workloads.push_back(callWorkload());
+    workloads.push_back(memoryWorkload());
+    workloads.push_back(timerPollWorkload(frameCycles));
+    return workloads;
+}
+
+bool loadWorkload(std::string path, Workload &workload){
+    std::ifstream romFile(path, std::ios_base::binary);
+    if(!romFile.good()){
+        return false;
+    }
+
+    workload.program.assign(std::istreambuf_iterator<char>(romFile), std::istreambuf_iterator<char>());
+
+    // Name real ROMs after their file
+    std::size_t separator = path.find_last_of("/\\");
+    workload.name = (separator == std::string::npos)? path: path.substr(separator + 1);
+    workload.cyclesPerTimerTick = 0;
+    return true;
+}
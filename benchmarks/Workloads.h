@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <stdint.h>
+
+/**
+ * Workload
+ *
+ * A program to benchmark the Interpreter with.
+ **/
+struct Workload{
+    std::string name;
+    std::vector<uint8_t> program; // The program image, loaded at 0x200
+    uint32_t cyclesPerTimerTick; // 0 to tick the timers once per frame
+};
+
+/**
+ * Generates the synthetic workloads
+ *
+ * - alu: 8XYN arithmetic and logic with ADDI
+ * - draw-N: DRAW with a sprite height of N (1 - 15)
+ * - call: EXE/RET recursion 16 levels deep
+ * - memory: STRM/LDM of all 16 registers
+ * - timer-poll: STRD polling the delay timer until it expires
+ *
+ * @param frameCycles - the cycles per 60 Hz frame
+ **/
+std::vector<Workload> generateWorkloads(uint32_t frameCycles);
+
+/**
+ * Loads a ROM file as a workload
+ *
+ * @param path - the path of the ROM file
+ * @param workload - receives the workload
+ * @return true if the ROM could be read
+ **/
+bool loadWorkload(std::string path, Workload &workload);
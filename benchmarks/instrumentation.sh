@@ -0,0 +1,52 @@
+#!/bin/sh
+# Checks that the instruction counters cost nothing when compiled out, by
+# comparing the default build against the same sources with the
+# instrumentation blocks removed, and reports their cost when compiled in
+#
+# Usage: benchmarks/instrumentation.sh [build directory] [benchmark options]
+set -e
+
+SOURCE=$(cd "$(dirname "$0")/.." && pwd)
+BUILD=${1:-$SOURCE/build-instrumentation}
+if [ $# -gt 0 ]; then shift; fi
+
+# Uninstrumented reference: drop the #ifdef blocks and keep the #ifndef ones
+rm -rf "$BUILD/source"
+mkdir -p "$BUILD/source"
+cp -R "$SOURCE/CMakeLists.txt" "$SOURCE/src" "$SOURCE/include" "$SOURCE/benchmarks" \
+    "$SOURCE/tools" "$SOURCE/tests" "$SOURCE/fuzz" "$BUILD/source"
+for FILE in $(grep -rl CHIPM8_INSTRUMENTATION "$BUILD/source/src" "$BUILD/source/include"); do
+    awk '
+        /^#ifdef CHIPM8_INSTRUMENTATION/ { skip = 1; next }
+        /^#ifndef CHIPM8_INSTRUMENTATION/ { keep = 1; next }
+        /^#endif/ && (skip || keep) { skip = 0; keep = 0; next }
+        !skip
+    ' "$FILE" > "$FILE.stripped"
+    mv "$FILE.stripped" "$FILE"
+done
+
+cmake -S "$BUILD/source" -B "$BUILD/uninstrumented" -DCMAKE_BUILD_TYPE=Release
+cmake --build "$BUILD/uninstrumented" --target Benchmarks
+cmake -S "$SOURCE" -B "$BUILD/disabled" -DCMAKE_BUILD_TYPE=Release -DCHIPM8_INSTRUMENTATION=OFF
+cmake --build "$BUILD/disabled" --target Benchmarks
+cmake -S "$SOURCE" -B "$BUILD/enabled" -DCMAKE_BUILD_TYPE=Release -DCHIPM8_INSTRUMENTATION=ON
+cmake --build "$BUILD/enabled" --target Benchmarks
+
+# Compiled out, the library's object code matches the uninstrumented one
+for OBJECT in $(cd "$BUILD/uninstrumented" && find CMakeFiles/ChipM8.dir -name "*.o"); do
+    objdump -d "$BUILD/uninstrumented/$OBJECT" | tail -n +4 > "$BUILD/uninstrumented.s"
+    objdump -d "$BUILD/disabled/$OBJECT" | tail -n +4 > "$BUILD/disabled.s"
+    if ! cmp -s "$BUILD/uninstrumented.s" "$BUILD/disabled.s"; then
+        echo "Object code differs: $OBJECT"
+    fi
+done
+
+"$BUILD/uninstrumented/Benchmarks" --json "$BUILD/uninstrumented.json" "$@" > /dev/null
+
+# Counting every instruction is expected to be slower, so it does not fail
+echo "Instruction counters compiled in, against an uninstrumented build:"
+"$BUILD/enabled/Benchmarks" --baseline "$BUILD/uninstrumented.json" "$@" || true
+
+echo
+echo "Instruction counters compiled out, against an uninstrumented build:"
+"$BUILD/disabled/Benchmarks" --baseline "$BUILD/uninstrumented.json" "$@"
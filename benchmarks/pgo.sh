@@ -0,0 +1,27 @@
+#!/bin/sh
+# Builds the Benchmarks with LTO and PGO and reports the speedup over the
+# default Release build
+#
+# Usage: benchmarks/pgo.sh [build directory] [benchmark options]
+set -e
+
+SOURCE=$(cd "$(dirname "$0")/.." && pwd)
+BUILD=${1:-$SOURCE/build-pgo}
+if [ $# -gt 0 ]; then shift; fi
+
+# Default build, the reference for the report
+cmake -S "$SOURCE" -B "$BUILD/default" -DCMAKE_BUILD_TYPE=Release
+cmake --build "$BUILD/default" --target Benchmarks
+
+# Instrument, train on the workloads and bundled ROMs, then optimize in place
+cmake -S "$SOURCE" -B "$BUILD/optimized" -DCMAKE_BUILD_TYPE=Release -DCHIPM8_LTO=ON -DCHIPM8_PGO=GENERATE
+cmake --build "$BUILD/optimized" --target pgo-train
+cmake -S "$SOURCE" -B "$BUILD/optimized" -DCHIPM8_PGO=USE
+cmake --build "$BUILD/optimized" --target Benchmarks
+
+ROMS=$(ls "$SOURCE"/benchmarks/roms/*.ch8)
+"$BUILD/default/Benchmarks" --json "$BUILD/default.json" "$@" $ROMS > /dev/null
+
+# Negative deltas are speedups, regressions are reported without failing
+echo "Speedup of LTO + PGO over the default build:"
+"$BUILD/optimized/Benchmarks" --baseline "$BUILD/default.json" "$@" $ROMS || true
@@ -0,0 +1,107 @@
+#include <ChipM8/System/Interpreter.h>
+
+#include <cstddef>
+
+#include <stdint.h>
+
+/**
+ * libFuzzer harness for the Interpreter
+ *
+ * The input is a ROM image followed by an input schedule:
+ *
+ *   uint16 ROM length (big endian, capped at 0xE00)
+ *   ROM bytes, loaded at 0x200
+ *   pairs of (frames to run, event) where an event presses
+ *   key (event & 0xF) if bit 4 is set and releases it otherwise
+ *
+ * Each iteration restores a pristine snapshot taken once at
+ * startup, so only the memory pages the previous iteration
+ * wrote are copied back. The fuzzer is guided by the Chip8
+ * program's own coverage: the PC and the edge between
+ * consecutive PCs of every executed instruction are counted
+ * in libFuzzer's extra counters.
+ **/
+
+static const uint32_t CYCLES_PER_FRAME = 100; // Cycles per 60 Hz frame
+static const std::size_t MAX_FRAMES = 10; // Frames to run per input at most
+static const std::size_t MAX_ROM_SIZE = 0xE00; // Memory from 0x200 to 0xFFF
+
+static const std::size_t PC_COUNTERS = 0x1000;
+static const std::size_t EDGE_COUNTERS = 0x2000;
+
+// libFuzzer clears these before every run and collects them after it
+__attribute__((section("__libfuzzer_extra_counters")))
+static uint8_t coverage[PC_COUNTERS + EDGE_COUNTERS];
+
+/**
+ * Runs the Interpreter for a number of cycles, counting
+ * the coverage of every executed instruction
+ *
+ * @param interpreter - the interpreter to run
+ * @param cycles - the number of cycles to run
+ * @param previous - the hashed PC of the previous instruction
+ **/
+static void runCovered(Interpreter &interpreter, std::size_t cycles, uint16_t &previous){
+    for(std::size_t cycle = 0; cycle < cycles; cycle++){
+        // Nothing changes until the next key event
+        if(interpreter.hasExecutionHalted()){
+            interpreter.run(cycles - cycle);
+            return;
+        }
+
+        uint16_t pc = interpreter.registers.PC & 0xFFF;
+        uint16_t current = (uint16_t) ((pc * 0x9E37u) >> 3) & (EDGE_COUNTERS - 1);
+        coverage[pc]++;
+        coverage[PC_COUNTERS + (current ^ previous)]++;
+        previous = current >> 1;
+
+        interpreter.tick();
+    }
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, std::size_t size){
+    static Interpreter *interpreter = nullptr;
+    static Snapshot pristine;
+    if(interpreter == nullptr){
+        interpreter = new Interpreter();
+        interpreter->setCyclesPerTimerTick(CYCLES_PER_FRAME);
+        interpreter->saveSnapshot(pristine);
+    }
+
+    if(size < 2){
+        return 0;
+    }
+
+    std::size_t romSize = (data[0] << 8) | data[1];
+    if(romSize > MAX_ROM_SIZE){
+        romSize = MAX_ROM_SIZE;
+    }
+    if(romSize > size - 2){
+        romSize = size - 2;
+    }
+
+    interpreter->restoreSnapshot(pristine);
+    interpreter->loadProgram(data + 2, romSize);
+
+    const uint8_t *schedule = data + 2 + romSize;
+    std::size_t events = (size - 2 - romSize) / 2;
+
+    uint16_t previous = 0;
+    std::size_t frames = 0;
+    for(std::size_t event = 0; event <= events && frames < MAX_FRAMES; event++){
+        // Run until the next event, or to the end after the last one
+        std::size_t framesToRun = (event < events)? schedule[event * 2]: MAX_FRAMES;
+        if(framesToRun > MAX_FRAMES - frames){
+            framesToRun = MAX_FRAMES - frames;
+        }
+        runCovered(*interpreter, framesToRun * CYCLES_PER_FRAME, previous);
+        frames += framesToRun;
+
+        if(event < events){
+            uint8_t action = schedule[event * 2 + 1];
+            interpreter->input.setKeyPressed(action & 0xF, (action & 0x10) != 0);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,72 @@
+#include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <stdint.h>
+
+/**
+ * Standalone driver for the fuzz harness
+ *
+ * Used in place of libFuzzer when the compiler does not
+ * support -fsanitize=fuzzer. Replays the given input files,
+ * e.g. to reproduce a crash, or with no files runs random
+ * inputs and reports the executions per second.
+ *
+ * Usage: InterpreterFuzzer [-runs=N] [input files...]
+ **/
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, std::size_t size);
+
+int main(int argc, char *argv[]){
+    std::size_t runs = 100000;
+    std::vector<std::string> paths;
+
+    for(int arg = 1; arg < argc; arg++){
+        std::string argument = argv[arg];
+        if(argument.compare(0, 6, "-runs=") == 0){
+            runs = std::stoul(argument.substr(6));
+        }else{
+            paths.push_back(argument);
+        }
+    }
+
+    for(const std::string &path: paths){
+        std::ifstream file(path, std::ios::binary);
+        if(!file.is_open()){
+            std::cerr << "Unable to open " << path << std::endl;
+            return 1;
+        }
+        std::vector<uint8_t> input((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        LLVMFuzzerTestOneInput(input.data(), input.size());
+        std::cout << "Executed " << path << " (" << input.size() << " bytes)" << std::endl;
+    }
+    if(!paths.empty()){
+        return 0;
+    }
+
+    // Random ROMs of up to 512 bytes followed by a short schedule
+    std::mt19937 generator(0);
+    std::vector<uint8_t> input;
+
+    auto start = std::chrono::steady_clock::now();
+    for(std::size_t run = 0; run < runs; run++){
+        std::size_t romSize = generator() % 512;
+        input.resize(2 + romSize + 16);
+        input[0] = (uint8_t) (romSize >> 8);
+        input[1] = (uint8_t) romSize;
+        for(std::size_t byte = 2; byte < input.size(); byte++){
+            input[byte] = (uint8_t) generator();
+        }
+        LLVMFuzzerTestOneInput(input.data(), input.size());
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << "Executed " << runs << " random inputs in " << elapsed.count() << " s ("
+        << (uint64_t) (runs / elapsed.count()) << " exec/s)" << std::endl;
+    return 0;
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+#include "../System/Memory.h"
+
+#include <cstddef>
+#include <vector>
+
+#include <stdint.h>
+
+/**
+ * Edge Kinds
+ **/
+enum class EdgeKind : uint8_t {
+    Fallthrough,    // Execution continues into the next block
+    Jump,           // JUMP to the target
+    Skip,           // A skip instruction either skipping or not
+    Call,           // EXE of the subroutine at the target
+    Return          // Where execution resumes after an EXE returns
+};
+
+/**
+ * Control Flow Edge
+ **/
+struct Edge{
+    uint16_t target; // Address of the successor block
+    EdgeKind kind;
+};
+
+/**
+ * Basic Block
+ *
+ * A straight line run of instructions, entered only at
+ * its first instruction and left only after its last.
+ **/
+struct BasicBlock{
+    uint16_t start; // Address of the first instruction
+    uint16_t end; // Address following the last instruction
+    uint16_t instructions; // Number of instructions in the block
+    std::vector<Edge> successors;
+    bool computedJump; // Ends in a BR, whose targets are unknown
+    bool returns; // Ends in a RET
+};
+
+/**
+ * Static Control Flow Graph
+ *
+ * Disassembles a program without running it, starting from its
+ * entry point and following the JUMP, EXE and skip edges of the
+ * instructions exactly as the Interpreter decodes them. The
+ * reachable instructions are split into basic blocks.
+ *
+ * Computed jumps (BR) cannot be followed statically, so the
+ * blocks ending in them are flagged instead. Any bytes of the
+ * program which are never reached as instructions are reported
+ * as data regions.
+ **/
+class ControlFlowGraph{
+    public:
+        /**
+         * Builds the graph of a program image
+         *
+         * @param program - the program image
+         * @param size - the size of the program image in bytes
+         * @param origin - the address the program is loaded at,
+         * which is also its entry point, wrapped to 12 bits
+         **/
+        ControlFlowGraph(const uint8_t *program, std::size_t size, uint16_t origin = 0x200);
+
+        /**
+         * Builds the graph of a program in memory
+         *
+         * @param memory - the memory holding the program
+         * @param entry - the entry point of the program
+         * @param size - the size of the program in bytes
+         **/
+        ControlFlowGraph(Memory &memory, uint16_t entry, std::size_t size);
+
+        /**
+         * Gets the basic blocks, ordered by address
+         **/
+        const std::vector<BasicBlock> &getBlocks();
+
+        /**
+         * Gets the basic block containing an instruction
+         *
+         * @param address - the address of the instruction
+         * @return the block, or nullptr if the address is not
+         * the start of a reachable instruction
+         **/
+        const BasicBlock *findBlock(uint16_t address);
+
+        /**
+         * Checks if an address holds the start of a
+         * reachable instruction
+         *
+         * @param address - the address to check
+         **/
+        bool isInstruction(uint16_t address);
+
+        /**
+         * Checks if a byte is part of a reachable instruction
+         *
+         * @param address - the address of the byte
+         **/
+        bool isCode(uint16_t address);
+
+        /**
+         * Gets the entry points of the subroutines called through EXE
+         **/
+        const std::vector<uint16_t> &getSubroutines();
+
+        /**
+         * Gets the addresses of the computed jumps (BR)
+         **/
+        const std::vector<uint16_t> &getComputedJumps();
+
+        /**
+         * Gets the regions of the program never reached as
+         * instructions, as [start, end) address pairs
+         **/
+        const std::vector<std::pair<uint16_t, uint16_t>> &getDataRegions();
+
+    private:
+        void build(uint16_t entry);
+        uint16_t fetch(uint16_t address);
+
+        uint8_t image[0x1000]; // The 4KB address space being analysed
+        uint16_t origin; // Start of the program
+        uint16_t programEnd; // End of the program
+
+        bool instructionStarts[0x1000]; // Reachable instruction addresses
+        bool codeBytes[0x1000]; // Bytes belonging to reachable instructions
+        bool leaders[0x1000]; // Addresses starting a basic block
+        bool subroutineEntries[0x1000]; // Addresses called through EXE
+        uint16_t blockIndex[0x1000]; // Block of each instruction
+
+        std::vector<BasicBlock> blocks;
+        std::vector<uint16_t> subroutines;
+        std::vector<uint16_t> computedJumps;
+        std::vector<std::pair<uint16_t, uint16_t>> dataRegions;
+};
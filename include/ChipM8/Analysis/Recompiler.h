@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+#include <stdint.h>
+
+/**
+ * Writes a program recompiled to C++ source for a NativeProgram
+ *
+ * Every basic block of the program's ControlFlowGraph becomes a
+ * native function. Register, arithmetic, skip and jump instructions
+ * are compiled inline, while the rest (drawing, input, timers and
+ * memory accesses) call back into the Interpreter. Blocks are split
+ * after instructions which write memory or halt, so a block never
+ * runs past code it has just modified. Code only reachable through
+ * computed jumps is not compiled and is interpreted instead.
+ *
+ * The source only includes ChipM8/System/NativeBlock.h, e.g.
+ *
+ *   c++ -O2 -shared -fPIC -I include game.cpp -o game.so
+ *
+ * @param program - the program image
+ * @param size - the size of the program image in bytes
+ * @param name - the name of the program, for the header comment
+ * @param output - the stream to write the source to
+ * @param origin - the address the program is loaded at
+ * @return the number of native blocks written
+ **/
+std::size_t writeNativeSource(const uint8_t *program, std::size_t size, const std::string &name,
+    std::ostream &output, uint16_t origin = 0x200);
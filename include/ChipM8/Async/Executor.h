@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Session.h"
+#include "Task.h"
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * Executor
+ *
+ * A single threaded scheduler for the coroutines driving
+ * Sessions. The host calls runFrame at its frame rate (e.g.
+ * 60 Hz), which runs a frame of every suspended Session and
+ * resumes the coroutines whose awaited event occurred.
+ **/
+class Executor{
+    public:
+        /**
+         * Starts a task, running it until it first suspends
+         *
+         * The Executor owns the task until it finishes.
+         *
+         * @param task - the task to start
+         **/
+        void spawn(Task task);
+
+        /**
+         * Runs a frame of every suspended Session
+         *
+         * Finished tasks are released, and an exception
+         * escaping a task is rethrown from here.
+         **/
+        void runFrame();
+
+        /**
+         * Returns the number of unfinished tasks
+         **/
+        std::size_t getTaskCount();
+
+    private:
+        friend class Session;
+
+        /**
+         * Releases the finished tasks
+         **/
+        void releaseFinished();
+
+        std::vector<Task> tasks; // Unfinished tasks
+        std::vector<Session*> suspended; // Sessions awaiting a frame
+        std::vector<Session*> running; // Sessions of the current frame
+};
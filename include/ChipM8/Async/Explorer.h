@@ -0,0 +1,113 @@
+#pragma once
+
+#include "../System/Interpreter.h"
+#include "ThreadPool.h"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <stdint.h>
+
+/**
+ * A key press or release at the start of a frame
+ **/
+struct KeyEvent{
+    uint32_t frame; // The frame the event happens before, counted from 0
+    uint8_t key; // The key (0x0 - 0xF)
+    bool pressed; // Whether the key is pressed or released
+};
+
+/**
+ * The key events of a branch, ordered by frame
+ **/
+typedef std::vector<KeyEvent> InputSchedule;
+
+/**
+ * The final state of an explored branch
+ **/
+struct BranchResult{
+    Registers registers; // The final registers
+    Screen screen; // The final screen
+    uint64_t hash; // The final state hash (see Interpreter::hash)
+    uint32_t frames; // Frames run before finishing or being cut off
+    bool duplicate; // Whether the branch was cut off as a duplicate
+    std::size_t duplicateOf; // The branch whose final state it shares, if a duplicate
+};
+
+/**
+ * Explorer
+ *
+ * Runs many branches from the same snapshot in parallel, each
+ * with its own input schedule, for tree search over inputs.
+ *
+ * Each thread of the pool owns an Interpreter and forks a branch
+ * by restoring the base snapshot into it, which after the first
+ * branch only copies back the memory pages the previous branch
+ * wrote. A frame runs the cycles per frame and ticks the timers.
+ *
+ * After every frame a branch looks up its state hash, the pressed
+ * keys and the rest of its schedule. If another branch got there
+ * first, both will end in the same state, so the branch is cut off
+ * and given the other's final state. The RND generator is part of
+ * the snapshot, so branches executing RND are reproducible too.
+ **/
+class Explorer{
+    public:
+        /**
+         * Starts the thread pool
+         *
+         * @param cyclesPerFrame - cycles run per 60 Hz frame
+         * @param threads - the number of threads, or 0 for one
+         * per hardware thread
+         **/
+        Explorer(uint32_t cyclesPerFrame, std::size_t threads = 0);
+
+        /**
+         * Enables cutting off branches reaching a state
+         * another branch reached (enabled by default)
+         *
+         * @param enabled - whether to cut off duplicates
+         **/
+        void setDuplicateCutoff(bool enabled);
+
+        /**
+         * Runs a branch per schedule from a snapshot
+         *
+         * Blocks until all the branches are finished.
+         *
+         * @param base - the snapshot every branch starts from
+         * @param schedules - the key events of each branch
+         * @param frames - the frames to run each branch for
+         * @return the final state of each branch
+         **/
+        std::vector<BranchResult> explore(const Snapshot &base, const std::vector<InputSchedule> &schedules, uint32_t frames);
+
+        /**
+         * Returns the number of threads in the pool
+         **/
+        std::size_t getThreadCount();
+
+    private:
+        void runBranch(Interpreter &interpreter, std::size_t branch);
+        uint64_t branchKey(Interpreter &interpreter, const InputSchedule &schedule, std::size_t event, uint32_t frame);
+
+        uint32_t cyclesPerFrame; // Cycles run per frame
+        bool duplicateCutoff; // Whether duplicates are cut off
+
+        ThreadPool pool; // The threads running the branches
+        std::vector<std::unique_ptr<Interpreter>> interpreters; // The Interpreter of each thread
+
+        // The current job
+        const Snapshot *base; // The snapshot branches start from
+        const std::vector<InputSchedule> *schedules; // The schedules of the branches
+        uint32_t frames; // The frames to run each branch for
+        std::vector<BranchResult> results; // The results of the branches
+        std::atomic<std::size_t> nextBranch; // The next branch to run
+
+        std::mutex statesMutex; // Guards states
+        std::unordered_map<uint64_t, std::size_t> states; // The branch first reaching each state
+};
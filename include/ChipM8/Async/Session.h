@@ -0,0 +1,100 @@
+#pragma once
+
+#include "../System/Interpreter.h"
+
+#include <coroutine>
+#include <cstddef>
+
+#include <stdint.h>
+
+class Executor;
+
+/**
+ * The outcome of the frames run while a Session was suspended
+ **/
+struct FrameResult{
+    std::size_t frames; // Frames run while suspended
+    std::size_t instructions; // Instructions executed in those frames
+    bool waiting; // Whether execution is halted on a WAIT instruction
+    bool sounding; // Whether the sound timer is active
+};
+
+/**
+ * Session
+ *
+ * Runs an Interpreter from a coroutine (see Task) on an Executor.
+ * Each frame of the Executor runs the Interpreter's cycle budget
+ * for one frame and ticks its timers, and the coroutine suspends
+ * until the event it awaits:
+ *
+ * - nextFrame() resumes after the next frame
+ * - keyWait() resumes once a pending WAIT has been delivered a key
+ * - soundChange() resumes once the sound timer starts or stops
+ *
+ * Many sessions can be multiplexed on a single Executor thread.
+ * Keys may be pressed from any thread through the Interpreter's
+ * input, the delivery is noticed at the next frame.
+ **/
+class Session{
+    public:
+        /**
+         * The event a suspended Session resumes on
+         **/
+        enum class Event : uint8_t{
+            Frame, KeyWait, SoundChange
+        };
+
+        /**
+         * Awaits an event of the Session
+         **/
+        struct Awaiter{
+            bool await_ready();
+            void await_suspend(std::coroutine_handle<> handle);
+            FrameResult await_resume();
+
+            Session &session;
+            Event event;
+        };
+
+        /**
+         * @param interpreter - the interpreter to run
+         * @param executor - the executor running the frames
+         * @param cyclesPerFrame - cycles run per 60 Hz frame
+         **/
+        Session(Interpreter &interpreter, Executor &executor, std::size_t cyclesPerFrame);
+
+        /**
+         * Suspends until the next frame has run
+         **/
+        Awaiter nextFrame();
+
+        /**
+         * Suspends until the pending WAIT instruction has been
+         * delivered a key, resuming immediately if none is pending
+         **/
+        Awaiter keyWait();
+
+        /**
+         * Suspends until the sound timer starts or stops
+         **/
+        Awaiter soundChange();
+
+        Interpreter &interpreter; // The interpreter being run
+
+    private:
+        friend class Executor;
+
+        /**
+         * Runs one frame, returning true if the awaited
+         * event occurred
+         **/
+        bool runFrame();
+
+        Executor &executor;
+        std::size_t cyclesPerFrame;
+
+        Event event; // The event being awaited
+        std::coroutine_handle<> handle; // The suspended coroutine
+        bool soundingBefore; // Sound state when soundChange was awaited
+        FrameResult result; // Accumulated while suspended
+};
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <coroutine>
+#include <exception>
+
+/**
+ * Task
+ *
+ * The return type of a coroutine driving a Session, e.g.
+ *
+ *   Task play(Session &session){
+ *       while(true){
+ *           FrameResult frame = co_await session.nextFrame();
+ *           if(frame.waiting){
+ *               co_await session.keyWait();
+ *           }
+ *       }
+ *   }
+ *
+ * A Task does not start until it is spawned on an Executor,
+ * which then owns it until it finishes.
+ **/
+class Task{
+    public:
+        struct promise_type{
+            Task get_return_object(){
+                return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+            }
+
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            std::suspend_always final_suspend() noexcept { return {}; }
+
+            void return_void(){}
+
+            void unhandled_exception(){
+                exception = std::current_exception();
+            }
+
+            std::exception_ptr exception; // Thrown out of the coroutine, if any
+        };
+
+        Task(Task &&other) noexcept;
+        Task &operator=(Task &&other) noexcept;
+        ~Task();
+
+        Task(const Task &) = delete;
+        Task &operator=(const Task &) = delete;
+
+        /**
+         * Resumes the coroutine until it next suspends
+         **/
+        void resume();
+
+        /**
+         * Checks if the coroutine has finished
+         **/
+        bool done();
+
+        /**
+         * Rethrows the exception that finished the coroutine, if any
+         **/
+        void rethrowException();
+
+    private:
+        explicit Task(std::coroutine_handle<promise_type> handle);
+
+        std::coroutine_handle<promise_type> handle;
+};
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <stdint.h>
+
+/**
+ * ThreadPool
+ *
+ * A fixed set of threads which all run the same function
+ * each time run is called. The function is given the index
+ * of the thread running it, so work can be split by thread
+ * and per thread state (e.g. an Interpreter) reused.
+ **/
+class ThreadPool{
+    public:
+        /**
+         * Starts the threads
+         *
+         * @param threads - the number of threads, or 0 for one
+         * per hardware thread
+         **/
+        ThreadPool(std::size_t threads = 0);
+
+        /**
+         * Stops the threads
+         **/
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        /**
+         * Runs a function on every thread, blocking until
+         * all of them have returned
+         *
+         * @param function - called with the index of the thread
+         **/
+        void run(const std::function<void(std::size_t)> &function);
+
+        /**
+         * Returns the number of threads
+         **/
+        std::size_t getThreadCount();
+
+    private:
+        void work(std::size_t thread);
+
+        std::vector<std::thread> threads; // The threads
+
+        std::mutex mutex; // Guards the fields below
+        std::condition_variable started; // Signals a new job or stopping
+        std::condition_variable finished; // Signals a finished thread
+        const std::function<void(std::size_t)> *function; // The function of the current job
+        uint64_t job; // Incremented for every run
+        std::size_t busyThreads; // Threads still running the job
+        bool stopping; // Whether the threads should exit
+};
@@ -0,0 +1,171 @@
+#pragma once
+
+#include "../System/Interpreter.h"
+#include "ThreadPool.h"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <stdint.h>
+
+/**
+ * How a score is stored in memory
+ **/
+enum class RewardEncoding{
+    Binary, // An unsigned big endian number
+    BCD // One decimal digit per byte, most significant first (as BCD stores)
+};
+
+/**
+ * A score in memory whose change is paid out as reward
+ **/
+struct RewardSource{
+    uint16_t address; // The address of the first byte
+    uint8_t bytes; // The number of bytes
+    RewardEncoding encoding; // How the bytes encode the score
+    float scale; // Multiplies the change in score
+};
+
+/**
+ * VecEnv
+ *
+ * Steps a batch of environments, one Interpreter each, for
+ * training agents. An action is the mask of the keys held during
+ * a step (bit N for key N), and a step runs a number of frames,
+ * each the cycles per frame followed by a timer tick.
+ *
+ * The screens after a step are written into one caller owned
+ * buffer, either a byte per pixel or a bit per pixel, and the
+ * reward of each environment is the change in the scores read
+ * from its memory. The environments are split evenly between the
+ * threads of a pool and each thread only touches its own, so a
+ * step scales with the number of cores.
+ **/
+class VecEnv{
+    public:
+        /**
+         * Creates the environments, each restored from the same snapshot
+         *
+         * @param initial - the state the environments start and reset to
+         * @param environments - the number of environments
+         * @param cyclesPerFrame - cycles run per 60 Hz frame
+         * @param framesPerStep - frames run per step
+         * @param threads - the number of threads, or 0 for one
+         * per hardware thread
+         **/
+        VecEnv(const Snapshot &initial, std::size_t environments, uint32_t cyclesPerFrame, uint32_t framesPerStep = 4, std::size_t threads = 0);
+
+        /**
+         * Pays out the change of a score in memory as reward, the
+         * rewards of all the sources are summed
+         *
+         * @param address - the address of the score
+         * @param scale - multiplies the change in score
+         * @param bytes - the number of bytes of the score
+         * @param encoding - how the bytes encode the score
+         **/
+        void addReward(uint16_t address, float scale = 1.0f, uint8_t bytes = 1, RewardEncoding encoding = RewardEncoding::Binary);
+
+        /**
+         * Removes all the reward sources
+         **/
+        void clearRewards();
+
+        /**
+         * Seeds the RND generators of the environments from their
+         * next reset, each draws different numbers in every episode
+         *
+         * @param seed - the seed
+         **/
+        void setSeed(uint64_t seed);
+
+        /**
+         * Sets the frames run per step
+         *
+         * @param framesPerStep - frames run per step
+         **/
+        void setFramesPerStep(uint32_t framesPerStep);
+
+        /**
+         * Resets all the environments to the initial snapshot
+         **/
+        void reset();
+
+        /**
+         * Resets an environment to the initial snapshot, releasing its keys
+         *
+         * @param environment - the index of the environment
+         **/
+        void reset(std::size_t environment);
+
+        /**
+         * Steps every environment with its action
+         *
+         * @param actions - the key mask of each environment
+         * @param observations - receives the screens, [environments][32][64]
+         * bytes of 0 or 1, or nullptr
+         * @param rewards - receives the reward of each environment, or nullptr
+         **/
+        void step(const uint16_t *actions, uint8_t *observations, float *rewards);
+
+        /**
+         * Steps every environment with its action, with bit packed screens
+         *
+         * @param actions - the key mask of each environment
+         * @param observations - receives the screens, [environments][32] rows
+         * with column 0 in the most significant bit, or nullptr
+         * @param rewards - receives the reward of each environment, or nullptr
+         **/
+        void stepPacked(const uint16_t *actions, uint64_t *observations, float *rewards);
+
+        /**
+         * Writes the current screens without stepping (e.g. after a reset)
+         *
+         * @param observations - receives the screens, [environments][32][64] bytes
+         **/
+        void observe(uint8_t *observations);
+
+        /**
+         * Writes the current screens bit packed without stepping
+         *
+         * @param observations - receives the screens, [environments][32] rows
+         **/
+        void observePacked(uint64_t *observations);
+
+        /**
+         * Returns the Interpreter of an environment, e.g. to inspect it
+         *
+         * @param environment - the index of the environment
+         **/
+        Interpreter &getInterpreter(std::size_t environment);
+
+        /**
+         * Returns the number of environments
+         **/
+        std::size_t getEnvironmentCount();
+
+        /**
+         * Returns the number of threads
+         **/
+        std::size_t getThreadCount();
+
+    private:
+        void forEach(const uint16_t *actions, uint8_t *observations, uint64_t *packed, float *rewards);
+        void stepEnvironment(std::size_t environment, uint16_t action);
+        void writeObservation(std::size_t environment, uint8_t *observations, uint64_t *packed);
+        float collectReward(std::size_t environment);
+        double readScore(Interpreter &interpreter, const RewardSource &source);
+
+        Snapshot initial; // The state environments start and reset to
+        uint32_t cyclesPerFrame; // Cycles run per frame
+        uint32_t framesPerStep; // Frames run per step
+        std::vector<RewardSource> rewardSources; // The scores paid out as reward
+
+        ThreadPool pool; // The threads stepping the environments
+        std::vector<std::unique_ptr<Interpreter>> interpreters; // The Interpreter of each environment
+        std::vector<uint16_t> heldKeys; // The keys held in each environment
+        std::vector<uint64_t> episodes; // Resets of each environment so far
+        uint64_t seed; // Seeds the RND generators
+        std::vector<double> scores; // The last score of each environment and source
+};
@@ -2,14 +2,33 @@
 
 #include "../System/Registers.h"
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
 #include <stdint.h>
 
+/**
+ * The state of the keypad, as saved in a Snapshot
+ **/
+struct InputState{
+    bool keys[16]; // The pressed keys
+    bool waiting; // Whether a WAIT instruction is pending
+    uint8_t waitedRegister; // The register a pending WAIT stores into
+};
+
 /**
  * Keypad Input
  *
  * This class represents the Chip8 keypad input.
  * The Keypad has 16 keys with Hexadecimal
  * values for its input (0x0 - 0xF).
+ *
+ * setKeyPressed may be called from a different thread
+ * than the one running the Interpreter, which allows the
+ * Interpreter's thread to sleep in waitForDelivery while
+ * a WAIT instruction is pending.
  **/
 class Input{
     public:
@@ -46,10 +65,41 @@ class Input{
          **/
         bool isWaiting();
 
+        /**
+         * Blocks until a pending key press has been delivered.
+         **/
+        void waitForDelivery();
+
+        /**
+         * Blocks until a pending key press has been delivered
+         * or the deadline passes, whichever comes first.
+         *
+         * @param deadline - the latest time to block until
+         * @return true if the input is no longer waiting
+         **/
+        bool waitForDelivery(std::chrono::steady_clock::time_point deadline);
+
+        /**
+         * Returns the state of the keypad
+         **/
+        InputState getState();
+
+        /**
+         * Restores the state of the keypad
+         *
+         * @param state - the state to restore
+         * @param registers - the registers a pending WAIT
+         * stores the delivered key into
+         **/
+        void setState(const InputState &state, Registers &registers);
+
     private:
         Registers *registers;
         uint8_t waitedRegister;
         
-        bool keys[16];
-        bool waiting;
+        std::atomic<bool> keys[16];
+        std::atomic<bool> waiting;
+
+        std::mutex deliveryMutex; // Guards the delivery of a waited key
+        std::condition_variable delivered; // Signalled once a waited key is delivered
 };
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <span>
+
 #include <stdint.h>
 
 /**
@@ -8,9 +10,20 @@
  * This class respresents the 32 x 64 (Rows x Cols) monochrome screen.
  * Each of the pixels of the display are represented by a boolean
  * value.
+ *
+ * A Zobrist hash of the lit pixels is kept up to date as pixels
+ * change, for hashing the machine state every frame.
+ *
+ * The pixels are stored row by row, and getPixels/getRow give
+ * read only views of that storage for reading whole frames.
  **/
 class Screen{
     public:
+        /**
+         * Creates a clear screen
+         **/
+        Screen();
+
         /**
          * Sets the pixels on the screen.
          *
@@ -26,7 +39,38 @@ class Screen{
          * @param row - the row of the desired pixel
          * @param col - the column of the desired pixel
          **/
-        bool getPixel(uint8_t row, uint8_t col);
+        bool getPixel(uint8_t row, uint8_t col) const;
+
+        /**
+         * Returns a read only view of all the pixels, row by row
+         **/
+        inline std::span<const bool, 32 * 64> getPixels() const{
+            return std::span<const bool, 32 * 64>(&pixels[0][0], 32 * 64);
+        }
+
+        /**
+         * Returns a read only view of a row of pixels
+         *
+         * @param row - the row
+         **/
+        inline std::span<const bool, 64> getRow(uint8_t row) const{
+            return std::span<const bool, 64>(pixels[row]);
+        }
+
+        /**
+         * Packs each row into a 64 bit value, with column 0
+         * in the most significant bit
+         *
+         * @param rows - the 32 rows to pack into
+         **/
+        void packRows(uint64_t *rows) const;
+
+        /**
+         * Copies all the pixels, row by row, as 0 or 1 bytes
+         *
+         * @param pixels - the 32 * 64 bytes to copy into
+         **/
+        void copyPixels(uint8_t *pixels) const;
 
         /**
          * Clears the screen, sets all the screen
@@ -34,7 +78,28 @@ class Screen{
          **/
         void clear();
 
+        /**
+         * Returns the hash of the lit pixels, the XOR of
+         * their keys
+         **/
+        uint64_t getHash();
+
+        /**
+         * Compares the pixels of two screens, screens with
+         * different hashes are told apart without reading them
+         *
+         * @param other - the screen to compare with
+         **/
+        bool operator==(const Screen &other) const;
+
+        /**
+         * Hashes the pixels from scratch, giving the same
+         * value getHash tracks
+         **/
+        uint64_t computeHash();
+
     private:
         bool pixels[32][64]; // The 32 x 64 monochrome screen
+        uint64_t hash; // XOR of the keys of the lit pixels
 
 };
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+#include <stdint.h>
+
+/**
+ * Speaker
+ *
+ * This class represents the Chip8 buzzer. While the sound timer
+ * is non-zero a square wave tone is produced. The tone is rendered
+ * into signed 16-bit mono PCM samples which are placed into a
+ * lock-free single producer, single consumer ring buffer.
+ *
+ * The Interpreter is the producer. Tone changes are stamped with
+ * the cycle at which they occurred, and each cycle is mapped onto
+ * the sample timeline, so the tone starts and stops on the exact
+ * sample regardless of how often the host renders.
+ *
+ * An audio callback on another thread is the consumer and only
+ * ever calls readSamples and availableSamples.
+ *
+ * The Speaker is disabled until configured, in which case tone
+ * changes cost nothing.
+ **/
+class Speaker{
+    public:
+        Speaker();
+
+        /**
+         * Configures and enables the sample stream
+         *
+         * Must not be called while a consumer is reading samples.
+         *
+         * @param sampleRate - the number of samples per second
+         * @param toneFrequency - the frequency of the square wave in Hz
+         * @param cyclesPerSecond - the number of Interpreter cycles per second
+         * @param amplitude - the peak amplitude of the square wave
+         **/
+        void configure(uint32_t sampleRate, uint32_t toneFrequency, uint32_t cyclesPerSecond, int16_t amplitude = 8000);
+
+        /**
+         * Checks if the sample stream is enabled
+         **/
+        bool isEnabled();
+
+        /**
+         * Turns the tone on or off from the given cycle onwards
+         *
+         * @param on - value indicating if the tone is audible
+         * @param cycle - the cycle at which the change occurred
+         * @param endCycle - the cycle at which the tone stops by
+         * itself, if already known
+         **/
+        void setTone(bool on, uint64_t cycle, uint64_t endCycle = UINT64_MAX);
+
+        /**
+         * Silences the tone and moves the render position to the
+         * given cycle, as after the Interpreter's cycle count was
+         * reset or restored
+         *
+         * Samples already in the ring buffer are kept.
+         *
+         * @param cycle - the cycle rendering continues from
+         **/
+        void reset(uint64_t cycle);
+
+        /**
+         * Renders samples into the ring buffer up to the given cycle
+         *
+         * Samples which do not fit into the ring buffer are dropped.
+         *
+         * @param cycle - the cycle to render up to
+         **/
+        void render(uint64_t cycle);
+
+        /**
+         * Reads rendered samples out of the ring buffer
+         *
+         * @param samples - the buffer to write the samples into
+         * @param count - the maximum number of samples to read
+         * @return the number of samples read
+         **/
+        std::size_t readSamples(int16_t *samples, std::size_t count);
+
+        /**
+         * Returns the number of samples waiting to be read
+         **/
+        std::size_t availableSamples();
+
+        /**
+         * Returns the number of samples dropped due to a full
+         * ring buffer
+         **/
+        uint64_t droppedSamples();
+
+        static const std::size_t BUFFER_SIZE = 8192; // Ring buffer capacity, a power of 2
+
+    private:
+        uint64_t cycleToSample(uint64_t cycle);
+
+        int16_t buffer[BUFFER_SIZE]; // The sample ring buffer
+        std::atomic<std::size_t> readIndex; // Total samples consumed
+        std::atomic<std::size_t> writeIndex; // Total samples produced
+
+        uint32_t sampleRate;
+        uint32_t cyclesPerSecond;
+        uint32_t phaseStep; // Phase increment per sample (2^32 = one period)
+        int16_t amplitude;
+
+        uint64_t renderedSample; // Position of the next sample on the timeline
+        uint64_t toneEndSample; // The sample at which the tone stops by itself
+        uint64_t dropped;
+        uint32_t phase;
+        bool toneOn;
+};
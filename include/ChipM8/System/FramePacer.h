@@ -0,0 +1,120 @@
+#pragma once
+
+#include "Interpreter.h"
+
+#include <chrono>
+#include <cstddef>
+
+#include <stdint.h>
+
+/**
+ * Jitter and frame statistics of a FramePacer
+ *
+ * Jitter is how late the pacer woke up after a frame's deadline.
+ **/
+struct PacingStatistics{
+    uint64_t wakeups; // Deadlines waited for
+    uint64_t frames; // Frames emulated
+    uint64_t caughtUpFrames; // Late frames emulated back to back
+    uint64_t droppedFrames; // Late frames skipped
+    double meanJitter; // Mean jitter in nanoseconds
+    double jitterDeviation; // Standard deviation of the jitter in nanoseconds
+    int64_t maxJitter; // Largest jitter in nanoseconds
+};
+
+/**
+ * FramePacer
+ *
+ * Drives an Interpreter in real time at a fixed instruction rate,
+ * running the instructions of one frame and ticking the timers at
+ * each frame deadline (60 Hz by default).
+ *
+ * Each deadline is waited for with an absolute clock_nanosleep on
+ * the monotonic clock, which cannot drift, waking a short spin tail
+ * early and spinning the remainder to absorb the scheduler's wakeup
+ * latency. When frames are missed (e.g. the host stalled), the
+ * catch up policy emulates them back to back, up to a limit, while
+ * the drop policy skips them so emulated time falls behind instead.
+ **/
+class FramePacer{
+    public:
+        /**
+         * What to do with frames whose deadline has passed
+         **/
+        enum class Policy : uint8_t{
+            CatchUp, Drop
+        };
+
+        /**
+         * @param interpreter - the interpreter to drive
+         * @param instructionsPerSecond - the emulated instruction rate
+         * @param framesPerSecond - the rate of frames and timer ticks
+         **/
+        FramePacer(Interpreter &interpreter, uint32_t instructionsPerSecond, uint32_t framesPerSecond = 60);
+
+        /**
+         * Sets the policy for late frames
+         *
+         * @param policy - whether to catch up or drop late frames
+         * @param maxCatchUpFrames - late frames caught up at most
+         * per deadline, any beyond that are dropped
+         **/
+        void setPolicy(Policy policy, uint32_t maxCatchUpFrames = 5);
+
+        /**
+         * Sets how long before a deadline to stop sleeping and spin
+         *
+         * A longer tail lowers the jitter at the cost of CPU time.
+         *
+         * @param spinTail - the time spent spinning, 0 to only sleep
+         **/
+        void setSpinTail(std::chrono::nanoseconds spinTail);
+
+        /**
+         * Restarts the schedule, with the next deadline being now
+         **/
+        void start();
+
+        /**
+         * Waits for the next frame deadline, then emulates the frame
+         * and any late frames according to the policy
+         *
+         * The schedule starts on the first call if start was not called.
+         *
+         * @return the number of frames emulated
+         **/
+        std::size_t runFrame();
+
+        /**
+         * Returns the jitter and frame statistics
+         **/
+        PacingStatistics getStatistics();
+
+        /**
+         * Clears the jitter and frame statistics
+         **/
+        void resetStatistics();
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        void sleepUntil(Clock::time_point deadline);
+        Clock::time_point getDeadline(uint64_t frame);
+        void emulateFrame();
+
+        Interpreter &interpreter;
+        uint32_t instructionsPerSecond;
+        uint32_t framesPerSecond;
+
+        Policy policy;
+        uint32_t maxCatchUpFrames;
+        std::chrono::nanoseconds spinTail;
+
+        bool started;
+        Clock::time_point startTime; // Deadline of frame 0
+        uint64_t scheduledFrame; // Index of the next deadline
+        uint64_t emulatedFrames; // Frames emulated, for the instruction budget
+
+        PacingStatistics statistics;
+        double jitterSquares; // Sum of squared differences from the mean jitter
+};
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * Superinstructions
+ *
+ * Common opcode sequences which Interpreter::run executes as a
+ * single fused operation. A fused operation has exactly the same
+ * effect, and takes the same number of cycles, as executing the
+ * sequence one instruction at a time.
+ **/
+enum class Fusion : uint8_t {
+    PositionDraw,   // 6XNN 6YNN DXYN, positions and draws a sprite
+    IndexOffset,    // ANNN FX1E, points I into a table
+    TimerPoll,      // FX07 3X00 1NNN, loops until the delay timer expires
+    CountedLoop,    // 7X01 3XNN 1NNN, loops until VX reaches NN
+    COUNT           // The number of fusions
+};
+
+/**
+ * Returns the name of a fusion, e.g. "timer-poll"
+ *
+ * @param fusion - the fusion to name
+ **/
+const char *getFusionName(Fusion fusion);
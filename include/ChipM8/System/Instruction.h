@@ -0,0 +1,85 @@
+#pragma once
+
+#include <string>
+
+#include <stdint.h>
+
+/**
+ * Chip8 Instructions
+ *
+ * Each of the instructions understood by the Interpreter,
+ * using the same mnemonics as the Interpreter.
+ **/
+enum class Instruction : uint8_t {
+    OEXE,   // 0NNN
+    CLS,    // 00E0
+    RET,    // 00EE
+    JUMP,   // 1NNN
+    EXE,    // 2NNN
+    SEI,    // 3XNN
+    SNEI,   // 4XNN
+    SE,     // 5XY0
+    STRI,   // 6XNN
+    ADDI,   // 7XNN
+    COPY,   // 8XY0
+    OR,     // 8XY1
+    AND,    // 8XY2
+    XOR,    // 8XY3
+    ADD,    // 8XY4
+    SUB,    // 8XY5
+    RSH,    // 8XY6
+    SUBR,   // 8XY7
+    LSH,    // 8XYE
+    SNE,    // 9XY0
+    STR,    // ANNN
+    BR,     // BNNN
+    RND,    // CXNN
+    DRAW,   // DXYN
+    SP,     // EX9E
+    SNP,    // EXA1
+    STRD,   // FX07
+    WAIT,   // FX0A
+    SETD,   // FX15
+    SETS,   // FX18
+    OFFS,   // FX1E
+    NUM,    // FX29
+    BCD,    // FX33
+    STRM,   // FX55
+    LDM,    // FX65
+    COUNT   // The number of instructions
+};
+
+/**
+ * Decodes the instruction of an opcode
+ *
+ * Opcodes are decoded exactly as the Interpreter executes
+ * them, so unassigned opcodes map onto the instruction the
+ * Interpreter would execute in their place.
+ *
+ * @param opcode - the opcode to decode
+ **/
+Instruction decodeInstruction(uint16_t opcode);
+
+/**
+ * Gets the mnemonic of an instruction
+ *
+ * @param instruction - the instruction
+ **/
+const char *getInstructionName(Instruction instruction);
+
+/**
+ * Disassembles an opcode into its mnemonic and operands
+ *
+ * e.g. 0xD125 disassembles into "DRAW V1, V2, 0x5"
+ *
+ * @param opcode - the opcode to disassemble
+ **/
+std::string disassembleInstruction(uint16_t opcode);
+
+/**
+ * Checks if an instruction conditionally skips
+ * the following instruction
+ *
+ * @param instruction - the instruction
+ **/
+bool isSkipInstruction(Instruction instruction);
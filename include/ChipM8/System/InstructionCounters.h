@@ -0,0 +1,78 @@
+#pragma once
+
+#include "Instruction.h"
+
+#include <ostream>
+
+#include <stdint.h>
+
+/**
+ * Instruction Counters
+ *
+ * Counts the instructions executed by the Interpreter,
+ * broken down by instruction, by sprite height for DRAW,
+ * and by whether conditional skips were taken.
+ *
+ * The counters are only part of the Interpreter when the
+ * library is built with CHIPM8_INSTRUMENTATION defined.
+ * Otherwise none of the instrumentation is compiled in.
+ **/
+class InstructionCounters{
+    public:
+        InstructionCounters();
+
+        /**
+         * Records an executed instruction
+         *
+         * @param opcode - the opcode that was executed
+         * @param nextPC - the program counter before execution,
+         * already pointing at the following instruction
+         * @param resultPC - the program counter after execution
+         **/
+        void record(uint16_t opcode, uint16_t nextPC, uint16_t resultPC);
+
+        /**
+         * Gets the number of times an instruction was executed
+         *
+         * @param instruction - the instruction
+         **/
+        uint64_t getCount(Instruction instruction);
+
+        /**
+         * Gets the number of sprites of a height drawn
+         *
+         * @param height - the sprite height (0x0 - 0xF)
+         **/
+        uint64_t getSpriteHeightCount(uint8_t height);
+
+        /**
+         * Gets the number of times a skip instruction
+         * did or did not skip
+         *
+         * @param instruction - the skip instruction
+         * @param taken - value indicating skipped or not skipped
+         **/
+        uint64_t getSkipCount(Instruction instruction, bool taken);
+
+        /**
+         * Gets the total number of instructions executed
+         **/
+        uint64_t getTotal();
+
+        /**
+         * Resets all the counters to 0
+         **/
+        void reset();
+
+        /**
+         * Writes the counters as a JSON object
+         *
+         * @param out - the stream to write to
+         **/
+        void writeJSON(std::ostream &out);
+
+    private:
+        uint64_t counts[(uint8_t) Instruction::COUNT];
+        uint64_t skipsTaken[(uint8_t) Instruction::COUNT];
+        uint64_t spriteHeights[16];
+};
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "Registers.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <stdint.h>
+
+/**
+ * Trace Record
+ *
+ * A fixed-size record of one executed instruction. The
+ * register written by most instructions is VX, with VF
+ * holding the carry/borrow/collision flag, so both are
+ * captured after execution. X itself is part of the opcode.
+ **/
+struct TraceRecord{
+    uint16_t PC; // Address of the instruction
+    uint16_t opcode; // The instruction executed
+    uint16_t I; // Memory address register after execution
+    uint8_t VX; // Register X after execution
+    uint8_t VF; // Register F after execution
+};
+
+/**
+ * Trace Trigger
+ *
+ * Matches a traced instruction when the masked program
+ * counter and masked opcode both equal the given values.
+ * e.g. an opcodeMask of 0xF000 and opcodeValue of 0xB000
+ * triggers on the first BR instruction.
+ **/
+struct TraceTrigger{
+    uint16_t pcMask;
+    uint16_t pcValue;
+    uint16_t opcodeMask;
+    uint16_t opcodeValue;
+};
+
+/**
+ * Instruction Trace
+ *
+ * A ring buffer of binary trace records which always holds the
+ * most recently executed instructions. Recording costs a few
+ * stores per instruction, and the buffer is only written to disk
+ * when flushed, either on demand or when an armed trigger matches.
+ *
+ * The trace is attached to an Interpreter with setTrace.
+ * Flushed traces are decoded by the TraceDecoder tool.
+ *
+ * File format (little endian):
+ * - "C8TR" magic, uint16 version, uint16 record size
+ * - uint64 record count
+ * - records, oldest first, as PC, opcode, I, VX, VF
+ **/
+class InstructionTrace{
+    public:
+        /**
+         * Creates a trace with the given capacity
+         *
+         * @param capacity - the number of records held, rounded
+         * up to a power of 2
+         **/
+        InstructionTrace(std::size_t capacity = 0x10000);
+
+        /**
+         * Records an executed instruction
+         *
+         * @param pc - the address of the instruction
+         * @param opcode - the opcode executed
+         * @param registers - the registers after execution
+         **/
+        inline void record(uint16_t pc, uint16_t opcode, Registers &registers){
+            TraceRecord &record = records[recorded & mask];
+            record.PC = pc;
+            record.opcode = opcode;
+            record.I = registers.I;
+            record.VX = registers.V[(opcode & 0x0F00) >> 8];
+            record.VF = registers.V[0xF];
+            recorded++;
+
+            if(armed && (pc & trigger.pcMask) == trigger.pcValue && (opcode & trigger.opcodeMask) == trigger.opcodeValue){
+                fireTrigger();
+            }
+        }
+
+        /**
+         * Arms a trigger which flushes the trace to a file
+         *
+         * The trigger fires once and is then disarmed.
+         *
+         * @param trigger - the instruction to trigger on
+         * @param path - the file to flush the trace to
+         **/
+        void armTrigger(TraceTrigger trigger, std::string path);
+
+        /**
+         * Disarms the trigger
+         **/
+        void disarmTrigger();
+
+        /**
+         * Checks if the armed trigger has fired
+         **/
+        bool hasTriggered();
+
+        /**
+         * Writes the records held to a file, oldest first
+         *
+         * @param path - the file to write to
+         * @return true if the file was written
+         **/
+        bool flush(std::string path);
+
+        /**
+         * Returns the number of records held
+         **/
+        std::size_t size();
+
+        /**
+         * Gets a record held, oldest first
+         *
+         * @param index - the index of the record (0 - size()-1)
+         **/
+        TraceRecord getRecord(std::size_t index);
+
+        /**
+         * Discards all the records held
+         **/
+        void clear();
+
+        /**
+         * Reads the records of a flushed trace file
+         *
+         * @param path - the file to read
+         * @param records - receives the records, oldest first
+         * @return true if the file was a valid trace
+         **/
+        static bool read(std::string path, std::vector<TraceRecord> &records);
+
+    private:
+        void fireTrigger();
+
+        std::vector<TraceRecord> records; // The ring buffer
+        std::size_t mask; // Capacity - 1
+        uint64_t recorded; // Total number of records written
+
+        TraceTrigger trigger;
+        std::string triggerPath;
+        bool armed;
+        bool triggered;
+};
@@ -2,10 +2,41 @@
 
 #include "../Peripherals/Input.h"
 #include "../Peripherals/Screen.h"
+#include "../Peripherals/Speaker.h"
+#include "Fusion.h"
+#include "InstructionTrace.h"
 #include "Memory.h"
+#include "NativeProgram.h"
+#include "Profiler.h"
 #include "Registers.h"
+#include "Snapshot.h"
+#include "Timing.h"
 
+#ifdef CHIPM8_INSTRUMENTATION
+#include "InstructionCounters.h"
+#endif
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
 #include <string>
+#include <unordered_map>
+
+/**
+ * Why run returned before spending all of its cycles
+ **/
+enum class StopReason {
+    None, // run spent all of its cycles, or halted on WAIT
+    Watchpoint, // A watched address was accessed (see getWatchHit)
+    Breakpoint, // PC reached a breakpoint whose condition held
+    Step // A step requested by stepOver or stepOut completed
+};
+
+/**
+ * Decides if a breakpoint stops run, given the registers
+ * before the instruction at the breakpoint executes
+ **/
+typedef std::function<bool(const Registers &)> BreakpointCondition;
 
 /**
  * "Interpreter" for Chip8
@@ -15,9 +46,43 @@
 class Interpreter{
 
     public:
+        /**
+         * Creates an Interpreter booted with only the font in
+         * memory, and RND seeded differently from any other
+         **/
         Interpreter();
         ~Interpreter();
 
+        /**
+         * Resets the machine to power on, running an image
+         *
+         * The registers, screen, keys, timers, cycle count and
+         * memory are reset without allocating: memory shares all
+         * of its pages with the image again, keeping its private
+         * storage for reuse. Settings such as the timing model,
+         * fusion, breakpoints and attached traces are kept.
+         *
+         * @param image - the memory to run, e.g. from createImage
+         * @param seed - seeds the RND generator
+         **/
+        void reset(std::shared_ptr<const MemoryImage> image, uint64_t seed);
+
+        /**
+         * Creates a memory image of a program, with the font and
+         * the program loaded at 0x200, for reset
+         *
+         * @param program - the program image
+         * @param size - the size of the program image in bytes
+         **/
+        static std::shared_ptr<const MemoryImage> createImage(const uint8_t *program, std::size_t size);
+
+        /**
+         * Seeds the RND generator, which is saved in snapshots
+         *
+         * @param seed - the seed
+         **/
+        void setRandomSeed(uint64_t seed);
+
         /**
          * Ticks the Interpreter for one cycle
          *
@@ -25,19 +90,347 @@ class Interpreter{
          * responsibilities:
          * - Fetch the next instruction
          * - Process the instruction
+         *
+         * While execution is halted (see hasExecutionHalted)
+         * the cycle is spent waiting instead.
          **/
         void tick();
 
+        /**
+         * Runs the Interpreter for a number of cycles
+         *
+         * Execution stops early if the Interpreter halts on
+         * a WAIT instruction (0xFX0A). The remaining cycles are
+         * still spent waiting, so the cycle derived timers keep
+         * running while halted.
+         *
+         * With the VIP timing model (see setTimingModel) the
+         * cycles are machine cycles, and the last instruction may
+         * run past them. The cycles it ran over are taken from
+         * the next run, so the budget evens out over frames.
+         *
+         * With setFusion enabled, common opcode sequences are
+         * executed as superinstructions (see Fusion).
+         *
+         * When an instruction accesses an address watched with
+         * Memory::addWatchpoint, run stops once the instruction
+         * completes, leaving the remaining cycles unspent, and
+         * getStopReason returns Watchpoint. Calling run again
+         * continues from the next instruction. While any address
+         * is watched, neither fusion nor native code is used.
+         *
+         * Likewise run stops before executing an instruction at
+         * a breakpoint (see addBreakpoint), with PC pointing at
+         * it, or once a step completes. Calling run again then
+         * executes the instruction rather than stopping again.
+         *
+         * @param cycles - the number of cycles to run
+         * @return the number of instructions that were executed
+         **/
+        std::size_t run(std::size_t cycles);
+
         /**
          * Ticks the Sound and Delay timers
          *
-         * This function should be called at a rate
-         * of 60 Hz. It is separate from the
-         * main tick function due to a difference
-         * in clock rate.
+         * When the timers are host driven (the default), this
+         * function should be called at a rate of 60 Hz. It is
+         * separate from the main tick function due to a
+         * difference in clock rate.
+         *
+         * When the timers are derived from the cycle count
+         * (see setCyclesPerTimerTick) the timers run by
+         * themselves and this only refreshes the DT and ST
+         * registers.
+         *
+         * In both cases any tone produced up to the current
+         * cycle is rendered into the speaker's sample stream.
          **/
         void tickTimers();
 
+        /**
+         * Derives the timers from the cycle count
+         *
+         * Rather than being ticked by the host, the delay and
+         * sound timers are stored as the timer tick at which they
+         * expire, where one timer tick lasts the given number of
+         * cycles. Their values are only materialized when STRD
+         * reads them or the host queries them, making the timers
+         * exact and deterministic at any emulation speed.
+         *
+         * @param cycles - cycles per 60 Hz timer tick, or 0 to
+         * have the host drive the timers through tickTimers
+         **/
+        void setCyclesPerTimerTick(uint32_t cycles);
+
+        /**
+         * Returns the current value of the delay timer
+         *
+         * This also refreshes the DT register. The DT and ST
+         * registers only mirror the timers as last materialized,
+         * so the host sets the timers through setDelayTimer and
+         * setSoundTimer, a direct write to the registers is
+         * overwritten the next time the timer is materialized.
+         **/
+        uint8_t getDelayTimer();
+
+        /**
+         * Returns the current value of the sound timer
+         *
+         * This also refreshes the ST register.
+         **/
+        uint8_t getSoundTimer();
+
+        /**
+         * Sets the value of the delay timer
+         *
+         * @param value - the number of timer ticks until expiry
+         **/
+        void setDelayTimer(uint8_t value);
+
+        /**
+         * Sets the value of the sound timer
+         *
+         * @param value - the number of timer ticks until expiry
+         **/
+        void setSoundTimer(uint8_t value);
+
+        /**
+         * Sets how instructions are timed
+         *
+         * With TimingModel::Instruction (the default) every
+         * instruction takes one cycle. With TimingModel::VIP each
+         * takes the machine cycles the COSMAC VIP interpreter
+         * does (see getVipCycles), so DRAW heavy code runs slower
+         * than ALU code as it did on the VIP. A frame is then
+         * VIP_CYCLES_PER_FRAME cycles, which can also be passed to
+         * setCyclesPerTimerTick. Fusion and native code are not
+         * used with the VIP timing model.
+         *
+         * @param model - the timing model
+         **/
+        void setTimingModel(TimingModel model);
+
+        /**
+         * Returns how instructions are timed
+         **/
+        TimingModel getTimingModel();
+
+        /**
+         * Makes DRAW wait for the display, as it did on the
+         * COSMAC VIP (disabled by default)
+         *
+         * After a DRAW, run spends the rest of the frame waiting
+         * and executes the next instruction at the start of the
+         * next frame, limiting a program to 60 draws per second.
+         * With host driven timers a frame ends at the next
+         * tickTimers, so a run per frame stops at the first DRAW.
+         * With cycle derived timers (see setCyclesPerTimerTick)
+         * run skips ahead to the next timer tick and continues.
+         * The wait costs no host time, and nothing at all
+         * while disabled. Native code is not used while enabled.
+         *
+         * @param enabled - whether DRAW waits for the display
+         **/
+        void setDisplayWait(bool enabled);
+
+        /**
+         * Enables executing common opcode sequences as
+         * superinstructions in run (disabled by default)
+         *
+         * Every instruction executed then first checks for a
+         * fusable sequence, which only pays off for programs
+         * spending their time in such sequences.
+         *
+         * Fusion is never used while a trace or profiler is
+         * attached, or when built with instrumentation, as they
+         * observe every instruction.
+         *
+         * @param enabled - whether to fuse opcode sequences
+         **/
+        void setFusion(bool enabled);
+
+        /**
+         * Returns how often a fusion was executed
+         *
+         * @param fusion - the fusion to count
+         **/
+        uint64_t getFusionCount(Fusion fusion);
+
+        /**
+         * Returns the number of instructions executed by a fusion
+         *
+         * @param fusion - the fusion to count
+         **/
+        uint64_t getFusedInstructionCount(Fusion fusion);
+
+        /**
+         * Clears the fusion counts
+         **/
+        void resetFusionCounts();
+
+        /**
+         * Attaches a program recompiled to native code
+         *
+         * run then executes the native blocks of the program
+         * whenever PC reaches them (see NativeProgram). Like
+         * fusion, native code is not used while a trace or
+         * profiler is attached, or when built with instrumentation.
+         *
+         * @param program - the native program, or nullptr to
+         * only interpret
+         **/
+        void setNativeProgram(NativeProgram *program);
+
+        /**
+         * Returns the number of instructions executed as native code
+         **/
+        uint64_t getNativeInstructionCount();
+
+        /**
+         * Attaches a trace which records every executed instruction
+         *
+         * @param trace - the trace to record into, or nullptr to
+         * stop tracing
+         **/
+        void setTrace(InstructionTrace *trace);
+
+        /**
+         * Attaches a profiler which attributes the cycles of every
+         * executed instruction to its address and call stack
+         *
+         * The profiler's call stack is reconstructed from the
+         * current Chip8 stack when attached.
+         *
+         * @param profiler - the profiler to record into, or nullptr
+         * to stop profiling
+         **/
+        void setProfiler(Profiler *profiler);
+
+        /**
+         * Saves the machine state into a snapshot
+         *
+         * @param snapshot - the snapshot to save into
+         **/
+        void saveSnapshot(Snapshot &snapshot);
+
+        /**
+         * Restores the machine state from a snapshot
+         *
+         * When the snapshot is the one most recently saved or
+         * restored, only the memory pages written since are
+         * copied back. Otherwise all of memory is copied.
+         *
+         * @param snapshot - the snapshot to restore, which is
+         * ignored if nothing has been saved into it
+         **/
+        void restoreSnapshot(const Snapshot &snapshot);
+
+        /**
+         * Stops run before the instruction at an address
+         *
+         * The first byte of the instruction is replaced with a
+         * trap in a shadow copy of its page that instructions are
+         * fetched from (see Memory::setTrap), so neither run nor
+         * tick compare PC against the breakpoints and a run
+         * without breakpoints is as fast as ever. Native code is
+         * not used while any breakpoint is set.
+         *
+         * @param address - the address of the instruction
+         * @param condition - if given, only stop when it returns
+         * true, e.g. [](const Registers &registers){ return registers.V[0] == 3; }
+         **/
+        void addBreakpoint(uint16_t address, BreakpointCondition condition = nullptr);
+
+        /**
+         * Removes the breakpoint at an address
+         *
+         * @param address - the address of the instruction
+         **/
+        void removeBreakpoint(uint16_t address);
+
+        /**
+         * Removes all the breakpoints
+         **/
+        void clearBreakpoints();
+
+        /**
+         * Makes the next run stop with StopReason::Step after
+         * the instruction at PC, running a called subroutine
+         * (EXE) until it returns to the current stack depth
+         **/
+        void stepOver();
+
+        /**
+         * Makes the next run stop with StopReason::Step once
+         * the current subroutine returns to its caller
+         *
+         * @return false if no subroutine is running
+         **/
+        bool stepOut();
+
+        /**
+         * Cancels a step that has not completed yet
+         **/
+        void cancelStep();
+
+        /**
+         * Returns why the last run stopped early
+         **/
+        StopReason getStopReason();
+
+        /**
+         * Returns the watched access that last stopped run,
+         * with the address of the accessing instruction
+         **/
+        WatchHit getWatchHit();
+
+        /**
+         * Tracks the hash of memory on every write, so that
+         * hash costs O(1) (see Memory::setHashing)
+         *
+         * @param enabled - whether to track the hash
+         **/
+        void setStateHashing(bool enabled);
+
+        /**
+         * Hashes the machine state
+         *
+         * The hash covers the registers, the remaining timer
+         * ticks, a pending WAIT, the RND generator, the cycles
+         * owed by the last instruction and left to wait for the
+         * display, memory and the screen, but not the cycle
+         * count or the pressed keys. Memory and the screen are hashed incrementally
+         * as they are written, memory only while state hashing
+         * is enabled, otherwise it is hashed from scratch.
+         **/
+        uint64_t hash();
+
+        /**
+         * Hashes the machine state from scratch, giving the
+         * same value as hash
+         **/
+        uint64_t computeHash();
+
+        /**
+         * Makes hash compare the incrementally maintained hash
+         * with one computed from scratch, for checking
+         *
+         * @param enabled - whether to validate the hash
+         **/
+        void setHashValidation(bool enabled);
+
+        /**
+         * Returns the number of times hash differed from the
+         * hash computed from scratch while validating
+         **/
+        uint64_t getHashMismatchCount();
+
+        /**
+         * Returns the number of cycles executed since
+         * the Interpreter was created
+         **/
+        uint64_t getCycleCount();
+
         /**
          * Checks if the Interpreter is currently halted
          *
@@ -48,6 +441,30 @@ class Interpreter{
          **/
         bool hasExecutionHalted();
 
+        /**
+         * Blocks until the Interpreter is runnable
+         *
+         * Rather than spinning on hasExecutionHalted(), a host
+         * can sleep here until setKeyPressed delivers the key
+         * for a pending WAIT instruction. While asleep the
+         * delay and sound timers are ticked at 60 Hz, and no
+         * wakeups occur at all once both timers reach 0.
+         **/
+        void waitUntilRunnable();
+
+        /**
+         * Blocks until the Interpreter is runnable or the
+         * deadline passes
+         *
+         * Unlike waitUntilRunnable(), the timers are left
+         * untouched so that a host with its own 60 Hz
+         * schedule can pass its next frame as the deadline.
+         *
+         * @param deadline - the latest time to block until
+         * @return true if the Interpreter is runnable
+         **/
+        bool waitUntilRunnable(std::chrono::steady_clock::time_point deadline);
+
         /**
          * Loads the program from the given program path
          * 
@@ -55,11 +472,75 @@ class Interpreter{
          **/
         void loadProgram(std::string programPath);
 
+        /**
+         * Loads the program from a buffer
+         *
+         * @param program - the program image
+         * @param size - the size of the program image in bytes
+         **/
+        void loadProgram(const uint8_t *program, std::size_t size);
+
         Input input; // The input for the interpreter
         Memory memory; // Memory for Chip8. (4KB)
         Registers registers; // Registers associated with the Interpreter
         Screen screen; // The screen for the interpreter
+        Speaker speaker; // The buzzer driven by the sound timer
+
+#ifdef CHIPM8_INSTRUMENTATION
+        InstructionCounters counters; // Counts of the instructions executed
+#endif
     
     private:
         void executeInstruction(uint16_t opcode);
+        uint64_t executeFused(uint16_t opcode, uint64_t cycles);
+        uint64_t countFusion(Fusion fusion, uint64_t instructions);
+        uint64_t executeNativeBlock(uint64_t cycles);
+        void trap();
+        void stopAt(uint16_t pc, StopReason reason);
+        void armStep(uint16_t address, uint16_t sp);
+        void startDisplayWait();
+        bool waitForDisplay(uint64_t endCycle);
+        uint64_t combineStateHash(uint64_t memoryHash, uint64_t screenHash);
+        static void executeNative(Interpreter *interpreter, uint16_t opcode, uint32_t offset);
+        uint64_t timerClock();
+
+        uint64_t cycleCount; // Cycles executed so far
+        uint64_t cycleOvershoot; // Cycles the last instruction ran past a run's budget
+        uint64_t randomState; // State of the RND generator
+        TimingModel timingModel; // How instructions are timed
+        bool displayWait; // Whether DRAW waits for the display
+        uint64_t displayWaitCycle; // Cycle a DRAW waits for the display until
+
+        InstructionTrace *trace; // Optional trace of executed instructions
+        Profiler *profiler; // Optional profile of executed instructions
+
+        bool fusion; // Whether run fuses opcode sequences
+        uint64_t fusionCounts[(std::size_t) Fusion::COUNT]; // Times each fusion was executed
+        uint64_t fusedInstructions[(std::size_t) Fusion::COUNT]; // Instructions executed by each fusion
+
+        NativeProgram *nativeProgram; // Optional native code of the program
+        NativeContext nativeContext; // Passed to the native blocks
+        uint64_t nativeInstructions; // Instructions executed as native code
+
+        uint32_t cyclesPerTimerTick; // 0 when the timers are host driven
+        uint64_t hostTimerTicks; // Timer ticks from tickTimers
+        uint64_t delayExpiry; // Timer tick at which the delay timer reaches 0
+        uint64_t soundExpiry; // Timer tick at which the sound timer reaches 0
+
+        uint64_t memorySnapshot; // Snapshot the written pages are tracked against
+
+        StopReason stopReason; // Why the last run stopped early
+        WatchHit watchHit; // The watched access that stopped run
+        uint64_t stopCycle; // Cycle at which run stops, 0 once stopped early
+        bool trapped; // Whether the instruction just fetched was stopped on
+
+        std::unordered_map<uint16_t, BreakpointCondition> breakpoints; // Conditions of the breakpoints
+        uint32_t resumeAddress; // Breakpoint run continues from without stopping
+        bool stepping; // Whether a step is waiting at stepAddress
+        uint16_t stepAddress; // Address the step completes at
+        uint16_t stepSP; // Stack pointer the step completes at
+        bool singleStep; // Whether the next run executes a single instruction
+
+        bool hashValidation; // Whether hash checks against computeHash
+        uint64_t hashMismatches; // Times hash differed from computeHash
 };
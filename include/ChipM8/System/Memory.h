@@ -1,10 +1,373 @@
 #pragma once
 
 #include <cstddef>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
 #include <stdint.h>
 
-struct Memory{
-    uint8_t &operator[](std::size_t index); // Index operator
+/**
+ * An immutable 64KB image of memory shared between
+ * the Memory of many Interpreters
+ **/
+struct MemoryImage{
+    uint8_t data[0x10000]; // The contents of memory
+};
+
+/**
+ * The accesses a watchpoint stops on
+ **/
+enum class Watch : uint8_t {
+    Read = 1,
+    Write = 2,
+    Access = 3 // Both reads and writes
+};
+
+/**
+ * The first access to a watched address
+ **/
+struct WatchHit{
+    uint16_t pc; // Address of the accessing instruction, filled in by the Interpreter
+    uint16_t address; // The watched address accessed
+    Watch access; // Read or Write
+    uint8_t value; // The value read or written
+};
+
+/**
+ * The contents of a Memory, as saved in a Snapshot
+ *
+ * Only the private pages are copied, the rest refer
+ * to the shared image.
+ **/
+struct MemoryState{
+    std::shared_ptr<const MemoryImage> image; // The image shared pages map to
+    int16_t slots[0x100]; // Index of each private page in pages, or -1 if shared
+    std::vector<uint8_t> pages; // The contents of the private pages
+};
+
+/**
+ * Memory
+ *
+ * Memory is split into 256 pages of 256 bytes which are either
+ * shared with an immutable MemoryImage or private to this Memory.
+ * A shared page is copied into private storage on its first write,
+ * so Interpreters running the same ROM image only pay for the pages
+ * they modify. Private storage is kept once allocated, so restoring
+ * a snapshot does not allocate.
+ *
+ * The Interpreter reads and writes memory through read and write,
+ * which also keep track of the pages written to so that snapshots
+ * can be restored by copying back only those pages. The index
+ * operator is for the host and makes the page private, since the
+ * returned reference may be written through.
+ *
+ * Watchpoints are kept as flags per page. Writes to a page with a
+ * write watchpoint always take the slow path, as its write pointer
+ * is left null, and load checks the page's flags before reading,
+ * so accesses to unwatched pages cost the same as without any.
+ *
+ * Instructions are fetched through fetch, which reads a shadow copy
+ * of pages holding traps. In the shadow the first byte of a trapped
+ * instruction is replaced with TRAP_BYTE, turning it into a 0x0FNN
+ * (SYS) opcode, so breakpoints are only noticed when executed.
+ *
+ * With hashing enabled, every write takes the slow path to keep a
+ * Zobrist hash of the contents (see hashMemoryByte) up to date.
+ **/
+class Memory{
+    public:
+        static constexpr uint8_t TRAP_BYTE = 0x0F; // Fetched in place of the first byte of a trapped instruction
+
+        /**
+         * Creates a Memory sharing an image of all zeros
+         **/
+        Memory();
+
+        Memory(const Memory &) = delete;
+        Memory &operator=(const Memory &) = delete;
+
+        uint8_t &operator[](std::size_t index); // Index operator
+
+        /**
+         * Reads a byte of memory
+         *
+         * @param address - the address to read
+         **/
+        inline uint8_t read(uint16_t address){
+            return readPages[address >> 8][address & 0xFF];
+        }
+
+        /**
+         * Fetches a byte of an instruction, seeing traps
+         *
+         * @param address - the address to fetch
+         **/
+        inline uint8_t fetch(uint16_t address){
+            return fetchPages[address >> 8][address & 0xFF];
+        }
+
+        /**
+         * Reads a byte of data, checking read watchpoints
+         *
+         * Unlike read, which fetches instructions, this is
+         * how instructions read their operands.
+         *
+         * @param address - the address to read
+         **/
+        inline uint8_t load(uint16_t address){
+            if(pageFlags[address >> 8] & (uint8_t) Watch::Read){
+                return loadWatched(address);
+            }
+            return readPages[address >> 8][address & 0xFF];
+        }
+
+        /**
+         * Writes a byte of memory, copying a shared
+         * page on its first write and checking write
+         * watchpoints
+         *
+         * @param address - the address to write
+         * @param value - the value to write
+         **/
+        inline void write(uint16_t address, uint8_t value){
+            uint8_t *page = writePages[address >> 8];
+            if(page == nullptr){
+                writeSlow(address, value);
+                return;
+            }
+            page[address & 0xFF] = value;
+            writtenPages[address >> 8] = true;
+        }
+
+        /**
+         * Returns where a run of data bytes can be read
+         * directly, saving a lookup per byte
+         *
+         * @param address - the address of the first byte
+         * @param size - the number of bytes
+         * @return the bytes, or nullptr if the run crosses a
+         * page or is read watched, in which case each byte
+         * must be read with load
+         **/
+        inline const uint8_t *loadRun(uint16_t address, std::size_t size){
+            uint8_t page = address >> 8;
+            if((address & 0xFF) + size > 0x100 || (pageFlags[page] & (uint8_t) Watch::Read)){
+                return nullptr;
+            }
+            return readPages[page] + (address & 0xFF);
+        }
+
+        /**
+         * Returns where a run of bytes can be written
+         * directly, saving a lookup per byte
+         *
+         * The page is flagged as written, so all the
+         * bytes of the run must then be written.
+         *
+         * @param address - the address of the first byte
+         * @param size - the number of bytes
+         * @return the bytes, or nullptr if the run crosses a
+         * page or its page takes the slow path, in which case
+         * each byte must be written with write
+         **/
+        inline uint8_t *writeRun(uint16_t address, std::size_t size){
+            uint8_t page = address >> 8;
+            uint8_t *data = writePages[page];
+            if((address & 0xFF) + size > 0x100 || data == nullptr){
+                return nullptr;
+            }
+            writtenPages[page] = true;
+            return data + (address & 0xFF);
+        }
+
+        /**
+         * Watches an address for reads, writes or both,
+         * replacing any watchpoint already on it
+         *
+         * @param address - the address to watch
+         * @param access - the accesses to stop on
+         **/
+        void addWatchpoint(uint16_t address, Watch access);
+
+        /**
+         * Stops watching an address
+         *
+         * @param address - the watched address
+         **/
+        void removeWatchpoint(uint16_t address);
+
+        /**
+         * Removes all the watchpoints
+         **/
+        void clearWatchpoints();
+
+        /**
+         * Checks if any address is watched
+         **/
+        bool hasWatchpoints();
+
+        /**
+         * Traps the instruction at an address, so that fetch
+         * returns TRAP_BYTE in place of its first byte
+         *
+         * @param address - the address of the instruction
+         **/
+        void setTrap(uint16_t address);
+
+        /**
+         * Removes the trap at an address
+         *
+         * @param address - the address of the instruction
+         **/
+        void clearTrap(uint16_t address);
+
+        /**
+         * Checks if the instruction at an address is trapped
+         *
+         * @param address - the address of the instruction
+         **/
+        bool isTrap(uint16_t address);
+
+        /**
+         * Checks if any instruction is trapped
+         **/
+        bool hasTraps();
+
+        /**
+         * Copies the pages holding traps into their shadows
+         * again, as writes through the index operator are
+         * not seen by fetch until then
+         **/
+        void refreshTraps();
+
+        /**
+         * Keeps the hash of the contents up to date on every
+         * write while enabled, so getHash costs O(1)
+         *
+         * @param enabled - whether to track the hash
+         **/
+        void setHashing(bool enabled);
+
+        /**
+         * Checks if the hash is being tracked
+         **/
+        bool isHashing();
+
+        /**
+         * Returns the tracked hash of the contents
+         *
+         * Pages written through the index operator are hashed
+         * again here, as the writes cannot be seen.
+         **/
+        uint64_t getHash();
+
+        /**
+         * Hashes the whole contents from scratch, giving the
+         * same value getHash tracks
+         **/
+        uint64_t computeHash();
+
+        /**
+         * Checks if a watched address was accessed since
+         * the hit was last cleared
+         **/
+        inline bool hasWatchHit(){
+            return watchHitPending;
+        }
+
+        /**
+         * Returns the first watched access since the hit
+         * was last cleared, with a pc of 0
+         **/
+        WatchHit getWatchHit();
+
+        /**
+         * Clears the watch hit, so the next watched
+         * access is recorded
+         **/
+        void clearWatchHit();
+
+        /**
+         * Shares all the pages with an image, discarding
+         * the contents of the private pages
+         *
+         * @param image - the image to share
+         **/
+        void setImage(std::shared_ptr<const MemoryImage> image);
+
+        /**
+         * Creates an image of the current contents, e.g.
+         * to share a loaded ROM with other Interpreters
+         **/
+        std::shared_ptr<const MemoryImage> createImage();
+
+        /**
+         * Returns the number of pages that are private
+         **/
+        std::size_t getPrivatePageCount();
+
+        /**
+         * Checks if a page was written since the written
+         * flags were last cleared
+         *
+         * @param page - the page number (address >> 8)
+         **/
+        bool isPageWritten(uint8_t page);
+
+        /**
+         * Clears the written flags of all the pages
+         **/
+        void clearWrittenPages();
+
+        /**
+         * Saves the contents of memory
+         *
+         * @param state - the state to save into
+         **/
+        void saveState(MemoryState &state);
+
+        /**
+         * Restores the contents of memory
+         *
+         * @param state - the state to restore
+         * @param writtenOnly - only restore the pages written
+         * since the state was saved or last restored
+         **/
+        void restoreState(const MemoryState &state, bool writtenOnly);
+
+    private:
+        uint8_t *makePrivate(uint8_t page, bool copy);
+        void share(uint8_t page);
+        bool isPrivate(uint8_t page);
+        uint8_t loadWatched(uint16_t address);
+        void writeSlow(uint16_t address, uint8_t value);
+        void updatePageFlags(uint8_t page);
+        void updateFetchPage(uint8_t page);
+        void updateWritePage(uint8_t page);
+        void hashPage(uint8_t page);
+        bool divertsWrites(uint8_t page);
+
+        // Accessed by every instruction
+        const uint8_t *readPages[0x100]; // Where each page is read from
+        const uint8_t *fetchPages[0x100]; // Where instructions are fetched from, the shadow of trapped pages
+        uint8_t *writePages[0x100]; // Private storage of each page, nullptr when shared, write watched, trapped or hashing
+        bool writtenPages[0x100]; // Pages written since the flags were last cleared
+        uint8_t pageFlags[0x100]; // Watch flags of the watchpoints in each page, and TRAPPED_PAGE
+        bool watchHitPending; // Whether watchHit is set
+        bool hashing; // Whether writes update the hash
+
+        std::unique_ptr<uint8_t[]> storage[0x100]; // Private storage, allocated on first write
+        std::unique_ptr<uint8_t[]> shadowPages[0x100]; // Copies of trapped pages holding the traps
+        std::shared_ptr<const MemoryImage> image; // The image shared pages map to
+
+        std::unordered_map<uint16_t, Watch> watchpoints; // The watched addresses
+        std::unordered_set<uint16_t> traps; // The trapped instruction addresses
+        WatchHit watchHit; // The first watched access
 
-    uint8_t data[0x10000]; // The data store for memory
+        uint64_t hash; // XOR of pageHashes
+        uint64_t pageHashes[0x100]; // Hash of the contents of each page
+        bool staleHashPages[0x100]; // Pages written through the index operator since hashed
+        bool staleHash; // Whether any page is stale
 };
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "Registers.h"
+
+#include <stdint.h>
+
+class Interpreter;
+
+/**
+ * Native Block ABI
+ *
+ * The interface between the Interpreter and the C++ source written
+ * by the Recompiler. The generated code only depends on this header,
+ * so it compiles quickly and does not link against the library.
+ *
+ * A shared object exports the table of its blocks:
+ *
+ *   extern "C" const uint32_t chipm8_native_version;
+ *   extern "C" const uint32_t chipm8_native_block_count;
+ *   extern "C" const NativeBlock chipm8_native_blocks[];
+ **/
+static const uint32_t NATIVE_VERSION = 1;
+
+/**
+ * What a native block runs against
+ **/
+struct NativeContext{
+    Registers *registers; // The registers of the Interpreter
+    Interpreter *interpreter; // The Interpreter, only passed back to execute
+
+    /**
+     * Executes an instruction the native code does not inline
+     *
+     * PC must already point past the instruction. The offset is
+     * the number of instructions the block executed before it,
+     * which places the instruction at the right cycle.
+     **/
+    void (*execute)(Interpreter *interpreter, uint16_t opcode, uint32_t offset);
+};
+
+/**
+ * Runs a native block, returning the number of instructions executed
+ **/
+typedef uint32_t (*NativeFunction)(NativeContext &context);
+
+/**
+ * A straight line run of instructions compiled to native code
+ **/
+struct NativeBlock{
+    uint16_t start; // Address of the first instruction
+    uint16_t length; // Number of instructions
+    const uint8_t *code; // The opcodes compiled, to detect modified code
+    NativeFunction function; // The compiled instructions
+};
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "Memory.h"
+#include "NativeBlock.h"
+
+#include <cstddef>
+#include <string>
+
+#include <stdint.h>
+
+/**
+ * Native Program
+ *
+ * A ROM recompiled ahead of time to native code by the Recompiler
+ * tool and loaded from a shared object with dlopen. Attached with
+ * Interpreter::setNativeProgram, run executes a native block
+ * whenever PC reaches its start, as long as the code in memory is
+ * still the code that was compiled. Modified code, code reached
+ * only through computed jumps and blocks longer than the cycles
+ * left are interpreted instead.
+ **/
+class NativeProgram{
+    public:
+        NativeProgram();
+        ~NativeProgram();
+
+        NativeProgram(const NativeProgram &) = delete;
+        NativeProgram &operator=(const NativeProgram &) = delete;
+
+        /**
+         * Loads the blocks of a shared object
+         *
+         * @param path - the path of the shared object
+         * @return true if the blocks were loaded, otherwise
+         * getError describes the failure
+         **/
+        bool load(const std::string &path);
+
+        /**
+         * Returns why the last load failed
+         **/
+        std::string getError();
+
+        /**
+         * Returns the number of blocks loaded
+         **/
+        std::size_t getBlockCount();
+
+        /**
+         * Returns the block starting at an address
+         *
+         * @param address - the address of the first instruction
+         * @return the block, or nullptr if none starts there
+         **/
+        inline const NativeBlock *getBlock(uint16_t address){
+            return (address < 0x1000)? blocks[address]: nullptr;
+        }
+
+        /**
+         * Checks that memory still holds the code of a block
+         *
+         * @param block - the block to check
+         * @param memory - the memory to compare against
+         **/
+        inline bool isUnmodified(const NativeBlock &block, Memory &memory){
+            uint16_t address = block.start;
+            for(uint32_t byte = 0; byte < block.length * 2u; byte++){
+                if(memory.read(address) != block.code[byte]){
+                    return false;
+                }
+                address = (address + 1) & 0x0FFF;
+            }
+            return true;
+        }
+
+    private:
+        void unload();
+
+        void *handle; // The shared object
+        const NativeBlock *blocks[0x1000]; // The block starting at each address
+        std::size_t blockCount;
+        std::string error;
+};
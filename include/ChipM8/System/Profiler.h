@@ -0,0 +1,116 @@
+#pragma once
+
+#include "Memory.h"
+#include "Registers.h"
+
+#include <cstddef>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+
+#include <stdint.h>
+
+/**
+ * Profiler
+ *
+ * An exact profiler which attributes the cycles of every executed
+ * instruction to its address, and to the call stack of subroutines
+ * entered through EXE and left through RET.
+ *
+ * Call stacks are kept as a tree of subroutine entry addresses, so
+ * recording an instruction only adds to a counter in the current
+ * node. When attached part way through a program, the call stack is
+ * reconstructed from the return addresses held on the Chip8 stack.
+ *
+ * The profile is exported in the collapsed stack format used by
+ * flame graph tools, and as a per address heat table.
+ **/
+class Profiler{
+    public:
+        Profiler();
+
+        /**
+         * Records an executed instruction
+         *
+         * @param pc - the address of the instruction
+         * @param opcode - the opcode executed
+         * @param cycles - the cycles spent executing it
+         **/
+        inline void record(uint16_t pc, uint16_t opcode, uint32_t cycles){
+            pc &= 0x0FFF;
+            addressCycles[pc] += cycles;
+            opcodes[pc] = opcode;
+            nodes[current].cycles += cycles;
+
+            if((opcode & 0xF000) == 0x2000){
+                enter(opcode & 0x0FFF);
+            }else if(opcode == 0x00EE){
+                leave();
+            }
+        }
+
+        /**
+         * Reconstructs the call stack from the return
+         * addresses on the Chip8 stack
+         *
+         * @param memory - the memory holding the stack
+         * @param registers - the registers holding the stack pointer
+         **/
+        void synchronize(Memory &memory, Registers &registers);
+
+        /**
+         * Gets the cycles spent at an address
+         *
+         * @param address - the address of the instruction
+         **/
+        uint64_t getAddressCycles(uint16_t address);
+
+        /**
+         * Gets the total number of cycles recorded
+         **/
+        uint64_t getTotalCycles();
+
+        /**
+         * Writes the profile in collapsed stack format
+         *
+         * Each line holds the semicolon separated subroutine entry
+         * addresses from the outermost frame, followed by the cycles
+         * spent in that frame itself, e.g. "0x200;0x2A4 1500".
+         *
+         * @param out - the stream to write to
+         **/
+        void writeCollapsedStacks(std::ostream &out);
+
+        /**
+         * Writes the per address heat table as CSV
+         *
+         * @param out - the stream to write to
+         **/
+        void writeHeatTable(std::ostream &out);
+
+        /**
+         * Discards the profile
+         **/
+        void reset();
+
+        static const std::size_t MAX_DEPTH = 256; // Deeper calls are attributed to the deepest frame
+
+    private:
+        struct CallNode{
+            uint16_t address; // Subroutine entry address
+            uint32_t parent; // Index of the calling node
+            uint32_t depth;
+            uint64_t cycles; // Cycles spent in this frame itself
+        };
+
+        void enter(uint16_t address);
+        void leave();
+        void writeStack(std::ostream &out, uint32_t node);
+
+        std::vector<CallNode> nodes; // The call tree, node 0 is the root
+        std::unordered_map<uint64_t, uint32_t> children; // (parent, address) to child node
+        uint32_t current; // The node of the executing subroutine
+
+        uint64_t addressCycles[0x1000];
+        uint16_t opcodes[0x1000];
+};
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "../Peripherals/Input.h"
+#include "../Peripherals/Screen.h"
+#include "Memory.h"
+#include "Registers.h"
+
+#include <stdint.h>
+
+/**
+ * Snapshot
+ *
+ * The complete machine state of an Interpreter, as saved by
+ * Interpreter::saveSnapshot. Restoring the snapshot most
+ * recently saved or restored only copies back the memory pages
+ * written since, which makes resetting to a pristine state
+ * between short runs (e.g. fuzzing iterations) cheap. Pages
+ * shared with a MemoryImage are not copied at all.
+ *
+ * The speaker's sample stream, and any attached trace or
+ * profiler, are not part of the snapshot.
+ **/
+struct Snapshot{
+    Registers registers; // The registers
+    Screen screen; // The screen
+    InputState input; // The keypad
+    MemoryState memory; // The private pages of memory
+
+    uint64_t cycleCount; // Cycles executed so far
+    uint64_t cycleOvershoot; // Cycles run past the last run's budget
+    uint64_t displayWaitCycle; // Cycle a DRAW waits for the display until
+    uint64_t randomState; // State of the RND generator
+    uint32_t cyclesPerTimerTick; // 0 when the timers are host driven
+    uint64_t hostTimerTicks; // Timer ticks from tickTimers
+    uint64_t delayExpiry; // Timer tick at which the delay timer reaches 0
+    uint64_t soundExpiry; // Timer tick at which the sound timer reaches 0
+
+    uint64_t id = 0; // Identifies the saved state, 0 when empty
+};
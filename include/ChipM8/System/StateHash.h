@@ -0,0 +1,40 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * Mixes the bits of a value (the splitmix64 finalizer)
+ *
+ * @param value - the value to mix
+ **/
+inline uint64_t mixHash(uint64_t value){
+    value += 0x9E3779B97F4A7C15ull;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    return value ^ (value >> 31);
+}
+
+/**
+ * Combines a value into a hash, where the order of
+ * the values matters
+ *
+ * @param hash - the hash so far
+ * @param value - the value to combine
+ **/
+inline uint64_t combineHash(uint64_t hash, uint64_t value){
+    return mixHash(hash ^ mixHash(value));
+}
+
+/**
+ * Returns the Zobrist key of a byte of memory
+ *
+ * The hash of memory is the XOR of the keys of all of
+ * its bytes, so a write updates it by XORing out the
+ * key of the old value and XORing in the new one.
+ *
+ * @param address - the address of the byte
+ * @param value - the value of the byte
+ **/
+inline uint64_t hashMemoryByte(uint16_t address, uint8_t value){
+    return mixHash(((uint64_t) address << 8) | value);
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Registers.h"
+
+#include <stdint.h>
+
+/**
+ * How Interpreter::run counts cycles
+ **/
+enum class TimingModel : uint8_t {
+    Instruction,    // Every instruction takes one cycle
+    VIP             // Instructions take the machine cycles of the COSMAC VIP interpreter
+};
+
+/**
+ * Machine cycles per second of the COSMAC VIP, a 1.76 MHz
+ * CDP1802 taking 8 clocks per machine cycle
+ **/
+static constexpr uint32_t VIP_CYCLES_PER_SECOND = 220113;
+
+/**
+ * Machine cycles per 60 Hz frame of the COSMAC VIP
+ **/
+static constexpr uint32_t VIP_CYCLES_PER_FRAME = 3668;
+
+/**
+ * Returns the machine cycles the COSMAC VIP interpreter takes
+ * to fetch and execute an opcode
+ *
+ * The costs approximate the original interpreter, they are not
+ * measured to the cycle. DRAW costs a fixed setup plus a cost per
+ * sprite row, which is higher when VX is not a multiple of 8 and
+ * every row has to be shifted across two screen bytes. BCD grows
+ * with the digits of VX, STRM and LDM with the registers copied.
+ * Time stolen by the display's DMA is not deducted.
+ *
+ * @param opcode - the opcode
+ * @param registers - the registers before the opcode executes
+ **/
+uint32_t getVipCycles(uint16_t opcode, const Registers &registers);
@@ -0,0 +1,179 @@
+#include <ChipM8/Analysis/ControlFlowGraph.h>
+#include <ChipM8/System/Instruction.h>
+
+#include <algorithm>
+
+static const uint16_t NO_BLOCK = 0xFFFF;
+
+ControlFlowGraph::ControlFlowGraph(const uint8_t *program, std::size_t size, uint16_t origin){
+    origin &= 0x0FFF;
+    std::fill(image, image + 0x1000, 0);
+    for(std::size_t byte = 0; byte < size && origin + byte < 0x1000; byte++){
+        image[origin + byte] = program[byte];
+    }
+
+    this->origin = origin;
+    programEnd = std::min<std::size_t>(origin + size, 0x1000);
+    build(origin);
+}
+
+ControlFlowGraph::ControlFlowGraph(Memory &memory, uint16_t entry, std::size_t size){
+    for(std::size_t address = 0; address < 0x1000; address++){
+        image[address] = memory.read(address);
+    }
+
+    origin = entry & 0x0FFF;
+    programEnd = std::min<std::size_t>(origin + size, 0x1000);
+    build(origin);
+}
+
+uint16_t ControlFlowGraph::fetch(uint16_t address){
+    return (image[address & 0x0FFF] << 8) | image[(address + 1) & 0x0FFF];
+}
+
+void ControlFlowGraph::build(uint16_t entry){
+    std::fill(instructionStarts, instructionStarts + 0x1000, false);
+    std::fill(codeBytes, codeBytes + 0x1000, false);
+    std::fill(leaders, leaders + 0x1000, false);
+    std::fill(subroutineEntries, subroutineEntries + 0x1000, false);
+    std::fill(blockIndex, blockIndex + 0x1000, NO_BLOCK);
+
+    // Follow every edge from the entry point to find the
+    // reachable instructions and the leaders of the blocks
+    std::vector<uint16_t> worklist;
+    worklist.reserve(0x100);
+    leaders[entry] = true;
+    worklist.push_back(entry);
+
+    while(!worklist.empty()){
+        uint16_t address = worklist.back();
+        worklist.pop_back();
+
+        bool fallsThrough = true;
+        while(fallsThrough && !instructionStarts[address]){
+            instructionStarts[address] = true;
+            codeBytes[address] = true;
+            codeBytes[(address + 1) & 0x0FFF] = true;
+
+            uint16_t opcode = fetch(address);
+            uint16_t next = (address + 2) & 0x0FFF;
+            uint16_t target = opcode & 0x0FFF;
+            Instruction instruction = decodeInstruction(opcode);
+
+            // Every instruction which transfers control ends its block
+            uint16_t successors[2];
+            std::size_t successorCount = 0;
+            if(instruction == Instruction::JUMP){
+                successors[successorCount++] = target;
+            }else if(instruction == Instruction::EXE){
+                successors[successorCount++] = target;
+                successors[successorCount++] = next;
+                subroutineEntries[target] = true;
+            }else if(isSkipInstruction(instruction)){
+                successors[successorCount++] = next;
+                successors[successorCount++] = (next + 2) & 0x0FFF;
+            }else if(instruction == Instruction::BR){
+                computedJumps.push_back(address);
+            }else if(instruction != Instruction::RET){
+                address = next;
+                continue;
+            }
+
+            for(std::size_t successor = 0; successor < successorCount; successor++){
+                leaders[successors[successor]] = true;
+                worklist.push_back(successors[successor]);
+            }
+            fallsThrough = false;
+        }
+    }
+
+    std::sort(computedJumps.begin(), computedJumps.end());
+
+    // Split the reachable instructions into blocks
+    for(uint16_t start = 0; start < 0x1000; start++){
+        if(subroutineEntries[start]){
+            subroutines.push_back(start);
+        }
+
+        if(!leaders[start] || !instructionStarts[start]){
+            continue;
+        }
+
+        BasicBlock block = {start, start, 0, {}, false, false};
+        uint16_t address = start;
+        for(;;){
+            blockIndex[address] = blocks.size();
+            block.instructions++;
+
+            uint16_t opcode = fetch(address);
+            uint16_t next = (address + 2) & 0x0FFF;
+            uint16_t target = opcode & 0x0FFF;
+            Instruction instruction = decodeInstruction(opcode);
+            block.end = next;
+
+            if(instruction == Instruction::JUMP){
+                block.successors.push_back({target, EdgeKind::Jump});
+            }else if(instruction == Instruction::EXE){
+                block.successors.push_back({target, EdgeKind::Call});
+                block.successors.push_back({next, EdgeKind::Return});
+            }else if(isSkipInstruction(instruction)){
+                block.successors.push_back({next, EdgeKind::Skip});
+                block.successors.push_back({(uint16_t) ((next + 2) & 0x0FFF), EdgeKind::Skip});
+            }else if(instruction == Instruction::BR){
+                block.computedJump = true;
+            }else if(instruction == Instruction::RET){
+                block.returns = true;
+            }else if(leaders[next] || block.instructions >= 0x800){
+                block.successors.push_back({next, EdgeKind::Fallthrough});
+            }else{
+                address = next;
+                continue;
+            }
+            break;
+        }
+
+        blocks.push_back(block);
+    }
+
+    // Anything in the program which is never reached is data
+    for(uint16_t address = origin; address < programEnd; address++){
+        if(codeBytes[address]){
+            continue;
+        }
+
+        if(!dataRegions.empty() && dataRegions.back().second == address){
+            dataRegions.back().second = address + 1;
+        }else{
+            dataRegions.push_back({address, (uint16_t) (address + 1)});
+        }
+    }
+}
+
+const std::vector<BasicBlock> &ControlFlowGraph::getBlocks(){
+    return blocks;
+}
+
+const BasicBlock *ControlFlowGraph::findBlock(uint16_t address){
+    uint16_t index = blockIndex[address & 0x0FFF];
+    return (index == NO_BLOCK)? nullptr: &blocks[index];
+}
+
+bool ControlFlowGraph::isInstruction(uint16_t address){
+    return instructionStarts[address & 0x0FFF];
+}
+
+bool ControlFlowGraph::isCode(uint16_t address){
+    return codeBytes[address & 0x0FFF];
+}
+
+const std::vector<uint16_t> &ControlFlowGraph::getSubroutines(){
+    return subroutines;
+}
+
+const std::vector<uint16_t> &ControlFlowGraph::getComputedJumps(){
+    return computedJumps;
+}
+
+const std::vector<std::pair<uint16_t, uint16_t>> &ControlFlowGraph::getDataRegions(){
+    return dataRegions;
+}
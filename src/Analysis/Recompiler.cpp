@@ -0,0 +1,217 @@
+#include <ChipM8/Analysis/Recompiler.h>
+
+#include <ChipM8/Analysis/ControlFlowGraph.h>
+#include <ChipM8/System/Instruction.h>
+#include <ChipM8/System/NativeBlock.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <stdio.h>
+
+/**
+ * Formats a value as hexadecimal, e.g. 0x20A
+ **/
+static std::string hex(unsigned value, int digits = 1){
+    char text[16];
+    snprintf(text, sizeof(text), "0x%0*X", digits, value);
+    return text;
+}
+
+/**
+ * Writes the statement executing an inlined instruction
+ *
+ * @return false if the instruction is not inlined
+ **/
+static bool writeInline(std::ostream &output, Instruction instruction, uint16_t opcode, uint16_t next){
+    std::string vx = "registers.V[" + hex((opcode & 0x0F00) >> 8) + "]";
+    std::string vy = "registers.V[" + hex((opcode & 0x00F0) >> 4) + "]";
+    std::string immediate = hex(opcode & 0x00FF, 2);
+    std::string address = hex(opcode & 0x0FFF, 3);
+
+    // Skips are relative to the incremented PC, without wrapping
+    std::string skipped = hex(next + 2, 3);
+    std::string notSkipped = hex(next, 3);
+
+    switch(instruction){
+        case Instruction::OEXE:
+            break;
+        case Instruction::JUMP:
+            output << "    registers.PC = " << address << ";\n";
+            break;
+        case Instruction::SEI:
+            output << "    registers.PC = (" << vx << " == " << immediate << ")? " << skipped << ": " << notSkipped << ";\n";
+            break;
+        case Instruction::SNEI:
+            output << "    registers.PC = (" << vx << " != " << immediate << ")? " << skipped << ": " << notSkipped << ";\n";
+            break;
+        case Instruction::SE:
+            output << "    registers.PC = (" << vx << " == " << vy << ")? " << skipped << ": " << notSkipped << ";\n";
+            break;
+        case Instruction::SNE:
+            output << "    registers.PC = (" << vx << " != " << vy << ")? " << skipped << ": " << notSkipped << ";\n";
+            break;
+        case Instruction::STRI:
+            output << "    " << vx << " = " << immediate << ";\n";
+            break;
+        case Instruction::ADDI:
+            output << "    " << vx << " += " << immediate << ";\n";
+            break;
+        case Instruction::COPY:
+            output << "    " << vx << " = " << vy << ";\n";
+            break;
+        case Instruction::OR:
+            output << "    " << vx << " |= " << vy << ";\n";
+            break;
+        case Instruction::AND:
+            output << "    " << vx << " &= " << vy << ";\n";
+            break;
+        case Instruction::XOR:
+            output << "    " << vx << " ^= " << vy << ";\n";
+            break;
+        case Instruction::ADD:
+            output << "    result = " << vx << " + " << vy << ";\n"
+                << "    " << vx << " = result;\n"
+                << "    registers.V[0xF] = (result < 0x100)? 0: 1;\n";
+            break;
+        case Instruction::SUB:
+            output << "    result = " << vx << " - " << vy << ";\n"
+                << "    " << vx << " = result;\n"
+                << "    registers.V[0xF] = (result >= 0)? 1: 0;\n";
+            break;
+        case Instruction::SUBR:
+            output << "    result = " << vy << " - " << vx << ";\n"
+                << "    " << vx << " = result;\n"
+                << "    registers.V[0xF] = (result >= 0)? 1: 0;\n";
+            break;
+        case Instruction::RSH:
+            output << "    registers.V[0xF] = " << vy << " & 0x01;\n"
+                << "    " << vx << " = " << vy << " >> 1;\n";
+            break;
+        case Instruction::LSH:
+            output << "    registers.V[0xF] = (" << vy << " & 0x80) >> 7;\n"
+                << "    " << vx << " = " << vy << " << 1;\n";
+            break;
+        case Instruction::STR:
+            output << "    registers.I = " << address << ";\n";
+            break;
+        case Instruction::OFFS:
+            output << "    registers.I += " << vx << ";\n"
+                << "    registers.I %= 0x1000;\n";
+            break;
+        default:
+            return false;
+    }
+    return true;
+}
+
+/**
+ * Checks if an instruction ends a native block, because it
+ * transfers control, halts or may modify code
+ **/
+static bool endsBlock(Instruction instruction){
+    switch(instruction){
+        case Instruction::JUMP:
+        case Instruction::EXE:
+        case Instruction::RET:
+        case Instruction::BR:
+        case Instruction::WAIT:
+        case Instruction::BCD:
+        case Instruction::STRM:
+            return true;
+        default:
+            return isSkipInstruction(instruction);
+    }
+}
+
+/**
+ * Checks if an instruction sets PC itself
+ **/
+static bool setsPC(Instruction instruction){
+    return instruction == Instruction::JUMP || instruction == Instruction::EXE ||
+        instruction == Instruction::RET || instruction == Instruction::BR ||
+        isSkipInstruction(instruction);
+}
+
+std::size_t writeNativeSource(const uint8_t *program, std::size_t size, const std::string &name,
+    std::ostream &output, uint16_t origin){
+
+    uint8_t image[0x1000] = {0};
+    for(std::size_t byte = 0; byte < size && origin + byte < 0x1000; byte++){
+        image[origin + byte] = program[byte];
+    }
+
+    ControlFlowGraph graph(program, size, origin);
+
+    output << "// Recompiled from " << name << " by the ChipM8 Recompiler, do not edit\n"
+        << "#include <ChipM8/System/NativeBlock.h>\n";
+
+    // Native blocks as (start, length) pairs
+    std::vector<std::pair<uint16_t, uint16_t>> natives;
+
+    for(const BasicBlock &block : graph.getBlocks()){
+        uint16_t address = block.start;
+        uint16_t remaining = block.instructions;
+
+        while(remaining > 0){
+            uint16_t start = address;
+            uint16_t length = 0;
+            std::vector<uint8_t> code;
+
+            output << "\nstatic uint32_t block_" << hex(start, 3).substr(2) << "(NativeContext &context){\n"
+                << "    Registers &registers = *context.registers;\n"
+                << "    int result = 0;\n"
+                << "    (void) result;\n";
+
+            Instruction instruction = Instruction::OEXE;
+            uint16_t next = address;
+            while(remaining > 0){
+                uint16_t opcode = (image[address] << 8) | image[(address + 1) & 0x0FFF];
+                next = (address + 2) & 0x0FFF;
+                instruction = decodeInstruction(opcode);
+                code.push_back(image[address]);
+                code.push_back(image[(address + 1) & 0x0FFF]);
+
+                output << "\n    // " << hex(address, 3) << " " << hex(opcode, 4).substr(2) << " " << disassembleInstruction(opcode) << "\n";
+                if(!writeInline(output, instruction, opcode, next)){
+                    output << "    registers.PC = " << hex(next, 3) << ";\n"
+                        << "    context.execute(context.interpreter, " << hex(opcode, 4) << ", " << length << ");\n";
+                }
+
+                length++;
+                remaining--;
+                address = next;
+                if(endsBlock(instruction)){
+                    break;
+                }
+            }
+
+            if(!setsPC(instruction)){
+                output << "    registers.PC = " << hex(next, 3) << ";\n";
+            }
+            output << "    return " << length << ";\n"
+                << "}\n"
+                << "\nstatic const uint8_t code_" << hex(start, 3).substr(2) << "[] = {";
+            for(std::size_t byte = 0; byte < code.size(); byte++){
+                output << ((byte % 12 == 0)? "\n    ": " ") << hex(code[byte], 2) << ",";
+            }
+            output << "\n};\n";
+
+            natives.push_back({start, length});
+        }
+    }
+
+    output << "\nextern \"C\" const uint32_t chipm8_native_version = " << NATIVE_VERSION << ";\n"
+        << "extern \"C\" const uint32_t chipm8_native_block_count = " << natives.size() << ";\n"
+        << "extern \"C\" const NativeBlock chipm8_native_blocks[] = {\n";
+    for(const std::pair<uint16_t, uint16_t> &native : natives){
+        std::string suffix = hex(native.first, 3).substr(2);
+        output << "    {" << hex(native.first, 3) << ", " << native.second << ", code_" << suffix << ", block_" << suffix << "},\n";
+    }
+    if(natives.empty()){
+        output << "    {0x000, 0, nullptr, nullptr},\n";
+    }
+    output << "};\n";
+
+    return natives.size();
+}
@@ -0,0 +1,41 @@
+#include <ChipM8/Async/Executor.h>
+
+void Executor::spawn(Task task){
+    task.resume();
+    tasks.push_back(std::move(task));
+    releaseFinished();
+}
+
+void Executor::runFrame(){
+    // Resumed coroutines suspend again into a fresh list
+    running.swap(suspended);
+    suspended.clear();
+
+    for(Session *session: running){
+        if(session->runFrame()){
+            session->handle.resume();
+        }else{
+            suspended.push_back(session);
+        }
+    }
+    running.clear();
+
+    releaseFinished();
+}
+
+std::size_t Executor::getTaskCount(){
+    return tasks.size();
+}
+
+void Executor::releaseFinished(){
+    for(std::size_t task = 0; task < tasks.size();){
+        if(tasks[task].done()){
+            Task finished = std::move(tasks[task]);
+            tasks[task] = std::move(tasks.back());
+            tasks.pop_back();
+            finished.rethrowException();
+        }else{
+            task++;
+        }
+    }
+}
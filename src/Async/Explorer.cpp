@@ -0,0 +1,108 @@
+#include <ChipM8/Async/Explorer.h>
+#include <ChipM8/System/StateHash.h>
+
+Explorer::Explorer(uint32_t cyclesPerFrame, std::size_t threads) : pool(threads){
+    this->cyclesPerFrame = cyclesPerFrame;
+    duplicateCutoff = true;
+
+    base = nullptr;
+    schedules = nullptr;
+    frames = 0;
+    nextBranch = 0;
+
+    // The Interpreters are created once, branches only restore snapshots
+    for(std::size_t thread = 0; thread < pool.getThreadCount(); thread++){
+        interpreters.emplace_back(new Interpreter());
+        interpreters.back()->setStateHashing(true);
+    }
+}
+
+void Explorer::setDuplicateCutoff(bool enabled){
+    duplicateCutoff = enabled;
+}
+
+std::vector<BranchResult> Explorer::explore(const Snapshot &base, const std::vector<InputSchedule> &schedules, uint32_t frames){
+    this->base = &base;
+    this->schedules = &schedules;
+    this->frames = frames;
+    results.assign(schedules.size(), BranchResult{});
+    nextBranch = 0;
+    states.clear();
+
+    pool.run([this](std::size_t thread){
+        for(std::size_t branch = nextBranch++; branch < this->schedules->size(); branch = nextBranch++){
+            runBranch(*interpreters[thread], branch);
+        }
+    });
+
+    // Duplicates end in the state of the branch they were cut off by
+    for(BranchResult &result : results){
+        if(result.duplicate){
+            while(results[result.duplicateOf].duplicate){
+                result.duplicateOf = results[result.duplicateOf].duplicateOf;
+            }
+            const BranchResult &original = results[result.duplicateOf];
+            result.registers = original.registers;
+            result.screen = original.screen;
+            result.hash = original.hash;
+        }
+    }
+
+    this->base = nullptr;
+    this->schedules = nullptr;
+    return std::move(results);
+}
+
+std::size_t Explorer::getThreadCount(){
+    return pool.getThreadCount();
+}
+
+void Explorer::runBranch(Interpreter &interpreter, std::size_t branch){
+    const InputSchedule &schedule = (*schedules)[branch];
+    BranchResult &result = results[branch];
+    result.duplicate = false;
+    result.duplicateOf = branch;
+
+    interpreter.restoreSnapshot(*base);
+
+    std::size_t event = 0;
+    for(uint32_t frame = 0; frame < frames; frame++){
+        for(; event < schedule.size() && schedule[event].frame <= frame; event++){
+            interpreter.input.setKeyPressed(schedule[event].key, schedule[event].pressed);
+        }
+        interpreter.run(cyclesPerFrame);
+        interpreter.tickTimers();
+
+        if(duplicateCutoff && frame + 1 < frames){
+            uint64_t key = branchKey(interpreter, schedule, event, frame + 1);
+            std::lock_guard<std::mutex> lock(statesMutex);
+            auto state = states.emplace(key, branch);
+            if(!state.second){
+                result.frames = frame + 1;
+                result.duplicate = true;
+                result.duplicateOf = state.first->second;
+                return;
+            }
+        }
+    }
+
+    result.registers = interpreter.registers;
+    result.screen = interpreter.screen;
+    result.hash = interpreter.hash();
+    result.frames = frames;
+}
+
+uint64_t Explorer::branchKey(Interpreter &interpreter, const InputSchedule &schedule, std::size_t event, uint32_t frame){
+    uint64_t key = combineHash(interpreter.hash(), frame);
+
+    InputState input = interpreter.input.getState();
+    for(std::size_t keyNumber = 0; keyNumber < 16; keyNumber++){
+        key = combineHash(key, input.keys[keyNumber]);
+    }
+
+    // The rest of the schedule, relative to the frame
+    for(; event < schedule.size(); event++){
+        key = combineHash(key, ((uint64_t) (schedule[event].frame - frame) << 16) | (schedule[event].key << 8) | schedule[event].pressed);
+    }
+    return key;
+}
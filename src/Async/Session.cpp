@@ -0,0 +1,64 @@
+#include <ChipM8/Async/Session.h>
+
+#include <ChipM8/Async/Executor.h>
+
+Session::Session(Interpreter &interpreter, Executor &executor, std::size_t cyclesPerFrame):
+    interpreter(interpreter), executor(executor), cyclesPerFrame(cyclesPerFrame){
+    event = Event::Frame;
+    soundingBefore = false;
+    result = FrameResult{0, 0, false, false};
+}
+
+Session::Awaiter Session::nextFrame(){
+    return Awaiter{*this, Event::Frame};
+}
+
+Session::Awaiter Session::keyWait(){
+    return Awaiter{*this, Event::KeyWait};
+}
+
+Session::Awaiter Session::soundChange(){
+    return Awaiter{*this, Event::SoundChange};
+}
+
+bool Session::runFrame(){
+    result.instructions += interpreter.run(cyclesPerFrame);
+    interpreter.tickTimers();
+    result.frames++;
+    result.waiting = interpreter.hasExecutionHalted();
+    result.sounding = interpreter.getSoundTimer() > 0;
+
+    switch(event){
+        case Event::Frame:
+            return true;
+        case Event::KeyWait:
+            return !result.waiting;
+        case Event::SoundChange:
+            return result.sounding != soundingBefore;
+    }
+    return true;
+}
+
+bool Session::Awaiter::await_ready(){
+    // A key wait with no pending WAIT has nothing to wait for
+    return event == Event::KeyWait && !session.interpreter.hasExecutionHalted();
+}
+
+void Session::Awaiter::await_suspend(std::coroutine_handle<> handle){
+    session.event = event;
+    session.handle = handle;
+    session.soundingBefore = session.interpreter.getSoundTimer() > 0;
+    session.result = FrameResult{0, 0, false, false};
+    session.executor.suspended.push_back(&session);
+}
+
+FrameResult Session::Awaiter::await_resume(){
+    if(session.result.frames == 0){
+        // Resumed without suspending
+        session.result.waiting = session.interpreter.hasExecutionHalted();
+        session.result.sounding = session.interpreter.getSoundTimer() > 0;
+    }
+    FrameResult result = session.result;
+    session.result = FrameResult{0, 0, false, false};
+    return result;
+}
@@ -0,0 +1,45 @@
+#include <ChipM8/Async/Task.h>
+
+Task::Task(std::coroutine_handle<promise_type> handle): handle(handle){
+}
+
+Task::Task(Task &&other) noexcept: handle(other.handle){
+    other.handle = nullptr;
+}
+
+Task &Task::operator=(Task &&other) noexcept{
+    if(this != &other){
+        if(handle){
+            handle.destroy();
+        }
+        handle = other.handle;
+        other.handle = nullptr;
+    }
+    return *this;
+}
+
+Task::~Task(){
+    if(handle){
+        handle.destroy();
+    }
+}
+
+void Task::resume(){
+    if(!handle || handle.done()){
+        return;
+    }
+
+    handle.resume();
+}
+
+bool Task::done(){
+    return !handle || handle.done();
+}
+
+void Task::rethrowException(){
+    if(handle && handle.promise().exception){
+        std::exception_ptr exception = handle.promise().exception;
+        handle.promise().exception = nullptr;
+        std::rethrow_exception(exception);
+    }
+}
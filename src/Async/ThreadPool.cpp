@@ -0,0 +1,62 @@
+#include <ChipM8/Async/ThreadPool.h>
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(std::size_t threads){
+    function = nullptr;
+    job = 0;
+    busyThreads = 0;
+    stopping = false;
+
+    if(threads == 0){
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for(std::size_t thread = 0; thread < threads; thread++){
+        this->threads.emplace_back(&ThreadPool::work, this, thread);
+    }
+}
+
+ThreadPool::~ThreadPool(){
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    started.notify_all();
+    for(std::thread &thread : threads){
+        thread.join();
+    }
+}
+
+void ThreadPool::run(const std::function<void(std::size_t)> &function){
+    std::unique_lock<std::mutex> lock(mutex);
+    this->function = &function;
+    job++;
+    busyThreads = threads.size();
+    started.notify_all();
+    finished.wait(lock, [this]{ return busyThreads == 0; });
+    this->function = nullptr;
+}
+
+std::size_t ThreadPool::getThreadCount(){
+    return threads.size();
+}
+
+void ThreadPool::work(std::size_t thread){
+    uint64_t finishedJob = 0;
+    std::unique_lock<std::mutex> lock(mutex);
+    while(true){
+        started.wait(lock, [&]{ return stopping || job != finishedJob; });
+        if(stopping){
+            return;
+        }
+
+        lock.unlock();
+        (*function)(thread);
+        lock.lock();
+
+        finishedJob = job;
+        if(--busyThreads == 0){
+            finished.notify_all();
+        }
+    }
+}
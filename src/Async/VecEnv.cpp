@@ -0,0 +1,154 @@
+#include <ChipM8/Async/VecEnv.h>
+#include <ChipM8/System/StateHash.h>
+
+VecEnv::VecEnv(const Snapshot &initial, std::size_t environments, uint32_t cyclesPerFrame, uint32_t framesPerStep, std::size_t threads) : initial(initial), pool(threads){
+    this->cyclesPerFrame = cyclesPerFrame;
+    this->framesPerStep = framesPerStep;
+    seed = 0;
+
+    for(std::size_t environment = 0; environment < environments; environment++){
+        interpreters.emplace_back(new Interpreter());
+    }
+    heldKeys.assign(environments, 0);
+    episodes.assign(environments, 0);
+    reset();
+}
+
+void VecEnv::addReward(uint16_t address, float scale, uint8_t bytes, RewardEncoding encoding){
+    rewardSources.push_back(RewardSource{address, bytes, encoding, scale});
+    scores.assign(interpreters.size() * rewardSources.size(), 0.0);
+    for(std::size_t environment = 0; environment < interpreters.size(); environment++){
+        collectReward(environment);
+    }
+}
+
+void VecEnv::clearRewards(){
+    rewardSources.clear();
+    scores.clear();
+}
+
+void VecEnv::setSeed(uint64_t seed){
+    this->seed = seed;
+}
+
+void VecEnv::setFramesPerStep(uint32_t framesPerStep){
+    this->framesPerStep = framesPerStep;
+}
+
+void VecEnv::reset(){
+    std::size_t threads = pool.getThreadCount();
+    pool.run([this, threads](std::size_t thread){
+        std::size_t end = (thread + 1) * interpreters.size() / threads;
+        for(std::size_t environment = thread * interpreters.size() / threads; environment < end; environment++){
+            reset(environment);
+        }
+    });
+}
+
+void VecEnv::reset(std::size_t environment){
+    Interpreter &interpreter = *interpreters[environment];
+    interpreter.restoreSnapshot(initial);
+    interpreter.setRandomSeed(combineHash(combineHash(seed, environment), episodes[environment]++));
+    for(uint8_t key = 0; key < 16; key++){
+        interpreter.input.setKeyPressed(key, false);
+    }
+    heldKeys[environment] = 0;
+    collectReward(environment);
+}
+
+void VecEnv::step(const uint16_t *actions, uint8_t *observations, float *rewards){
+    forEach(actions, observations, nullptr, rewards);
+}
+
+void VecEnv::stepPacked(const uint16_t *actions, uint64_t *observations, float *rewards){
+    forEach(actions, nullptr, observations, rewards);
+}
+
+void VecEnv::observe(uint8_t *observations){
+    for(std::size_t environment = 0; environment < interpreters.size(); environment++){
+        writeObservation(environment, observations, nullptr);
+    }
+}
+
+void VecEnv::observePacked(uint64_t *observations){
+    for(std::size_t environment = 0; environment < interpreters.size(); environment++){
+        writeObservation(environment, nullptr, observations);
+    }
+}
+
+Interpreter &VecEnv::getInterpreter(std::size_t environment){
+    return *interpreters[environment];
+}
+
+std::size_t VecEnv::getEnvironmentCount(){
+    return interpreters.size();
+}
+
+std::size_t VecEnv::getThreadCount(){
+    return pool.getThreadCount();
+}
+
+void VecEnv::forEach(const uint16_t *actions, uint8_t *observations, uint64_t *packed, float *rewards){
+    // Each thread steps a contiguous range, so no environment is shared
+    std::size_t threads = pool.getThreadCount();
+    pool.run([&](std::size_t thread){
+        std::size_t end = (thread + 1) * interpreters.size() / threads;
+        for(std::size_t environment = thread * interpreters.size() / threads; environment < end; environment++){
+            stepEnvironment(environment, actions[environment]);
+            writeObservation(environment, observations, packed);
+            float reward = collectReward(environment);
+            if(rewards != nullptr){
+                rewards[environment] = reward;
+            }
+        }
+    });
+}
+
+void VecEnv::stepEnvironment(std::size_t environment, uint16_t action){
+    Interpreter &interpreter = *interpreters[environment];
+
+    // Only changed keys are set, a held key is not pressed again for WAIT
+    uint16_t changed = action ^ heldKeys[environment];
+    for(uint8_t key = 0; key < 16; key++){
+        if(changed & (1 << key)){
+            interpreter.input.setKeyPressed(key, (action >> key) & 1);
+        }
+    }
+    heldKeys[environment] = action;
+
+    for(uint32_t frame = 0; frame < framesPerStep; frame++){
+        interpreter.run(cyclesPerFrame);
+        interpreter.tickTimers();
+    }
+}
+
+void VecEnv::writeObservation(std::size_t environment, uint8_t *observations, uint64_t *packed){
+    Screen &screen = interpreters[environment]->screen;
+    if(observations != nullptr){
+        screen.copyPixels(observations + environment * 32 * 64);
+    }
+    if(packed != nullptr){
+        screen.packRows(packed + environment * 32);
+    }
+}
+
+float VecEnv::collectReward(std::size_t environment){
+    double reward = 0.0;
+    double *previous = scores.data() + environment * rewardSources.size();
+    for(std::size_t source = 0; source < rewardSources.size(); source++){
+        double score = readScore(*interpreters[environment], rewardSources[source]);
+        reward += (score - previous[source]) * rewardSources[source].scale;
+        previous[source] = score;
+    }
+    return (float) reward;
+}
+
+double VecEnv::readScore(Interpreter &interpreter, const RewardSource &source){
+    double score = 0.0;
+    double base = source.encoding == RewardEncoding::BCD ? 10.0 : 256.0;
+    for(uint8_t byte = 0; byte < source.bytes; byte++){
+        // Reading does not make shared pages private
+        score = score * base + interpreter.memory.read(source.address + byte);
+    }
+    return score;
+}
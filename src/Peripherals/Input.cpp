@@ -2,30 +2,75 @@
 
 Input::Input(){
     for(uint8_t key = 0; key < 16; key++){
-        keys[key] = false;
+        keys[key].store(false, std::memory_order_relaxed);
     }
     waiting = false;
+    registers = nullptr;
+    waitedRegister = 0;
 }
 
 bool Input::isKeyPressed(uint8_t key){
-    return keys[key];
+    return keys[key].load(std::memory_order_relaxed);
 }
 
 void Input::setKeyPressed(uint8_t key, bool pressed){
-    keys[key] = pressed;
+    keys[key].store(pressed, std::memory_order_relaxed);
     // If the input was waiting, set the key
-    if(waiting && pressed){
-        registers->V[waitedRegister] = key;
-        waiting = false;
+    if(pressed && waiting.load(std::memory_order_acquire)){
+        std::lock_guard<std::mutex> lock(deliveryMutex);
+        if(waiting.load(std::memory_order_relaxed)){
+            registers->V[waitedRegister] = key;
+            waiting.store(false, std::memory_order_release);
+            delivered.notify_all();
+        }
     }
 }
 
 void Input::waitForKeyPress(Registers &registers, uint8_t registerX){
+    std::lock_guard<std::mutex> lock(deliveryMutex);
     this->registers = &registers;
     waitedRegister = registerX;
-    waiting = true;
+    waiting.store(true, std::memory_order_release);
 }
 
 bool Input::isWaiting(){
-    return waiting;
+    return waiting.load(std::memory_order_acquire);
+}
+
+void Input::waitForDelivery(){
+    std::unique_lock<std::mutex> lock(deliveryMutex);
+    delivered.wait(lock, [this]{
+        return !waiting.load(std::memory_order_relaxed);
+    });
+}
+
+bool Input::waitForDelivery(std::chrono::steady_clock::time_point deadline){
+    std::unique_lock<std::mutex> lock(deliveryMutex);
+    return delivered.wait_until(lock, deadline, [this]{
+        return !waiting.load(std::memory_order_relaxed);
+    });
+}
+
+InputState Input::getState(){
+    std::lock_guard<std::mutex> lock(deliveryMutex);
+    InputState state;
+    for(uint8_t key = 0; key < 16; key++){
+        state.keys[key] = keys[key].load(std::memory_order_relaxed);
+    }
+    state.waiting = waiting.load(std::memory_order_relaxed);
+    state.waitedRegister = waitedRegister;
+    return state;
+}
+
+void Input::setState(const InputState &state, Registers &registers){
+    std::lock_guard<std::mutex> lock(deliveryMutex);
+    for(uint8_t key = 0; key < 16; key++){
+        keys[key].store(state.keys[key], std::memory_order_relaxed);
+    }
+    this->registers = &registers;
+    waitedRegister = state.waitedRegister;
+    waiting.store(state.waiting, std::memory_order_release);
+    if(!state.waiting){
+        delivered.notify_all();
+    }
 }
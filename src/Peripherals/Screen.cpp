@@ -1,19 +1,87 @@
 #include <ChipM8/Peripherals/Screen.h>
+#include <ChipM8/System/StateHash.h>
 
+#include <bit>
 #include <cstddef>
+#include <cstring>
+
+/**
+ * The Zobrist keys of the pixels
+ **/
+struct PixelKeys{
+    PixelKeys(){
+        for(std::size_t row = 0; row < 32; row++){
+            for(std::size_t col = 0; col < 64; col++){
+                keys[row][col] = mixHash(0x1000000 + (row << 6) + col);
+            }
+        }
+    }
+
+    uint64_t keys[32][64];
+};
+
+static const PixelKeys pixelKeys;
+
+Screen::Screen(){
+    clear();
+}
 
 void Screen::setPixel(uint8_t row, uint8_t col, bool lit){
+    // The key is toggled when the pixel changes
+    hash ^= pixelKeys.keys[row][col] & (0 - (uint64_t) (pixels[row][col] != lit));
     pixels[row][col] = lit;
 }
 
-bool Screen::getPixel(uint8_t row, uint8_t col){
+bool Screen::getPixel(uint8_t row, uint8_t col) const{
     return pixels[row][col];
 }
 
+void Screen::copyPixels(uint8_t *pixels) const{
+    // A bool is stored as a 0 or 1 byte, so the rows copy as they are
+    static_assert(sizeof(bool) == 1);
+    std::memcpy(pixels, this->pixels, sizeof(this->pixels));
+}
+
+void Screen::packRows(uint64_t *rows) const{
+    for(std::size_t row = 0; row < 32; row++){
+        uint64_t bits = 0;
+        if constexpr(std::endian::native == std::endian::little){
+            for(std::size_t col = 0; col < 64; col += 8){
+                uint64_t bytes;
+                std::memcpy(&bytes, &pixels[row][col], 8);
+                // Gathers bit 0 of byte i into bit 63 - i, none of the products overlap
+                bits = (bits << 8) | ((bytes * 0x8040201008040201ULL) >> 56);
+            }
+        }else{
+            for(std::size_t col = 0; col < 64; col++){
+                bits = (bits << 1) | pixels[row][col];
+            }
+        }
+        rows[row] = bits;
+    }
+}
+
 void Screen::clear(){
+    std::memset(pixels, 0, sizeof(pixels));
+    hash = 0;
+}
+
+uint64_t Screen::getHash(){
+    return hash;
+}
+
+bool Screen::operator==(const Screen &other) const{
+    return hash == other.hash && std::memcmp(pixels, other.pixels, sizeof(pixels)) == 0;
+}
+
+uint64_t Screen::computeHash(){
+    uint64_t computed = 0;
     for(std::size_t row = 0; row < 32; row++){
         for(std::size_t col = 0; col < 64; col++){
-            pixels[row][col] = false;
+            if(pixels[row][col]){
+                computed ^= pixelKeys.keys[row][col];
+            }
         }
     }
+    return computed;
 }
@@ -0,0 +1,119 @@
+#include <ChipM8/Peripherals/Speaker.h>
+
+const std::size_t Speaker::BUFFER_SIZE;
+
+Speaker::Speaker(){
+    readIndex = 0;
+    writeIndex = 0;
+    sampleRate = 0;
+    cyclesPerSecond = 0;
+    phaseStep = 0;
+    amplitude = 0;
+    renderedSample = 0;
+    toneEndSample = UINT64_MAX;
+    dropped = 0;
+    phase = 0;
+    toneOn = false;
+}
+
+void Speaker::configure(uint32_t sampleRate, uint32_t toneFrequency, uint32_t cyclesPerSecond, int16_t amplitude){
+    this->sampleRate = sampleRate;
+    this->cyclesPerSecond = cyclesPerSecond;
+    this->amplitude = amplitude;
+    phaseStep = (sampleRate == 0)? 0: (uint32_t) (((uint64_t) toneFrequency << 32) / sampleRate);
+
+    readIndex = 0;
+    writeIndex = 0;
+    renderedSample = 0;
+    dropped = 0;
+    phase = 0;
+}
+
+bool Speaker::isEnabled(){
+    return sampleRate != 0 && cyclesPerSecond != 0;
+}
+
+uint64_t Speaker::cycleToSample(uint64_t cycle){
+    // Split the multiplication to avoid overflowing on long runs
+    uint64_t seconds = cycle / cyclesPerSecond;
+    uint64_t remainder = cycle % cyclesPerSecond;
+    return seconds * sampleRate + (remainder * sampleRate) / cyclesPerSecond;
+}
+
+void Speaker::setTone(bool on, uint64_t cycle, uint64_t endCycle){
+    if(!isEnabled()){
+        return;
+    }
+
+    // Everything before the change uses the previous tone
+    render(cycle);
+    if(on != toneOn){
+        phase = 0;
+    }
+    toneOn = on;
+    toneEndSample = (endCycle == UINT64_MAX)? UINT64_MAX: cycleToSample(endCycle);
+}
+
+void Speaker::reset(uint64_t cycle){
+    toneOn = false;
+    toneEndSample = UINT64_MAX;
+    phase = 0;
+    renderedSample = isEnabled()? cycleToSample(cycle): 0;
+}
+
+void Speaker::render(uint64_t cycle){
+    if(!isEnabled()){
+        return;
+    }
+
+    uint64_t targetSample = cycleToSample(cycle);
+    std::size_t write = writeIndex.load(std::memory_order_relaxed);
+    std::size_t read = readIndex.load(std::memory_order_acquire);
+
+    while(renderedSample < targetSample){
+        if(renderedSample >= toneEndSample){
+            toneOn = false;
+        }
+
+        int16_t sample = 0;
+        if(toneOn){
+            sample = (phase < 0x80000000u)? amplitude: -amplitude;
+            phase += phaseStep;
+        }
+
+        if(write - read < BUFFER_SIZE){
+            buffer[write & (BUFFER_SIZE - 1)] = sample;
+            write++;
+        }else{
+            dropped++;
+        }
+        renderedSample++;
+    }
+
+    writeIndex.store(write, std::memory_order_release);
+}
+
+std::size_t Speaker::readSamples(int16_t *samples, std::size_t count){
+    std::size_t read = readIndex.load(std::memory_order_relaxed);
+    std::size_t write = writeIndex.load(std::memory_order_acquire);
+
+    std::size_t available = write - read;
+    if(count > available){
+        count = available;
+    }
+
+    for(std::size_t sample = 0; sample < count; sample++){
+        samples[sample] = buffer[(read + sample) & (BUFFER_SIZE - 1)];
+    }
+
+    readIndex.store(read + count, std::memory_order_release);
+    return count;
+}
+
+std::size_t Speaker::availableSamples(){
+    return writeIndex.load(std::memory_order_acquire) - readIndex.load(std::memory_order_relaxed);
+}
+
+uint64_t Speaker::droppedSamples(){
+    return dropped;
+}
@@ -0,0 +1,121 @@
+#include <ChipM8/System/FramePacer.h>
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+#if defined(__linux__) || defined(__FreeBSD__)
+#include <errno.h>
+#include <time.h>
+#define CHIPM8_CLOCK_NANOSLEEP
+#endif
+
+FramePacer::FramePacer(Interpreter &interpreter, uint32_t instructionsPerSecond, uint32_t framesPerSecond):
+    interpreter(interpreter), instructionsPerSecond(instructionsPerSecond), framesPerSecond(framesPerSecond){
+    policy = Policy::CatchUp;
+    maxCatchUpFrames = 5;
+    spinTail = std::chrono::microseconds(200);
+    started = false;
+    scheduledFrame = 0;
+    emulatedFrames = 0;
+    resetStatistics();
+}
+
+void FramePacer::setPolicy(Policy policy, uint32_t maxCatchUpFrames){
+    this->policy = policy;
+    this->maxCatchUpFrames = maxCatchUpFrames;
+}
+
+void FramePacer::setSpinTail(std::chrono::nanoseconds spinTail){
+    this->spinTail = spinTail;
+}
+
+void FramePacer::start(){
+    started = true;
+    startTime = Clock::now();
+    scheduledFrame = 0;
+}
+
+std::size_t FramePacer::runFrame(){
+    if(!started){
+        start();
+    }
+
+    Clock::time_point deadline = getDeadline(scheduledFrame);
+    sleepUntil(deadline);
+    Clock::time_point now = Clock::now();
+
+    // Welford's running mean and variance of the jitter
+    int64_t jitter = std::chrono::duration_cast<std::chrono::nanoseconds>(now - deadline).count();
+    statistics.wakeups++;
+    double difference = jitter - statistics.meanJitter;
+    statistics.meanJitter += difference / statistics.wakeups;
+    jitterSquares += difference * (jitter - statistics.meanJitter);
+    statistics.jitterDeviation = std::sqrt(jitterSquares / statistics.wakeups);
+    if(jitter > statistics.maxJitter){
+        statistics.maxJitter = jitter;
+    }
+
+    // Frames whose deadlines have passed, including this one
+    uint64_t elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(now - startTime).count();
+    uint64_t passed = elapsed * framesPerSecond / 1000000000ull + 1;
+    uint64_t due = (passed > scheduledFrame)? passed - scheduledFrame: 1;
+
+    uint64_t late = due - 1;
+    uint64_t caughtUp = (policy == Policy::CatchUp)? std::min<uint64_t>(late, maxCatchUpFrames): 0;
+
+    for(uint64_t frame = 0; frame < 1 + caughtUp; frame++){
+        emulateFrame();
+    }
+    statistics.caughtUpFrames += caughtUp;
+    statistics.droppedFrames += late - caughtUp;
+    scheduledFrame += due;
+
+    return 1 + caughtUp;
+}
+
+PacingStatistics FramePacer::getStatistics(){
+    return statistics;
+}
+
+void FramePacer::resetStatistics(){
+    statistics = PacingStatistics{0, 0, 0, 0, 0.0, 0.0, 0};
+    jitterSquares = 0.0;
+}
+
+void FramePacer::sleepUntil(Clock::time_point deadline){
+    Clock::time_point wake = deadline - spinTail;
+
+    if(Clock::now() < wake){
+#ifdef CHIPM8_CLOCK_NANOSLEEP
+        // steady_clock is CLOCK_MONOTONIC, so an absolute sleep does not drift
+        std::chrono::nanoseconds since = wake.time_since_epoch();
+        struct timespec time;
+        time.tv_sec = (time_t) std::chrono::duration_cast<std::chrono::seconds>(since).count();
+        time.tv_nsec = (long) (since.count() % 1000000000);
+        while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &time, nullptr) == EINTR){
+        }
+#else
+        std::this_thread::sleep_until(wake);
+#endif
+    }
+
+    while(Clock::now() < deadline){
+    }
+}
+
+FramePacer::Clock::time_point FramePacer::getDeadline(uint64_t frame){
+    return startTime + std::chrono::nanoseconds(frame * 1000000000ull / framesPerSecond);
+}
+
+void FramePacer::emulateFrame(){
+    // Spread the instruction rate over the frames without losing the remainder
+    uint64_t begin = emulatedFrames * instructionsPerSecond / framesPerSecond;
+    uint64_t end = (emulatedFrames + 1) * instructionsPerSecond / framesPerSecond;
+
+    interpreter.run(end - begin);
+    interpreter.tickTimers();
+
+    emulatedFrames++;
+    statistics.frames++;
+}
@@ -0,0 +1,12 @@
+#include <ChipM8/System/Fusion.h>
+
+const char *getFusionName(Fusion fusion){
+    static const char *names[] = {
+        "position-draw", "index-offset", "timer-poll", "counted-loop"
+    };
+
+    if(fusion >= Fusion::COUNT){
+        return "";
+    }
+    return names[(uint8_t) fusion];
+}
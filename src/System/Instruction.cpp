@@ -0,0 +1,138 @@
+#include <ChipM8/System/Instruction.h>
+
+#include <stdio.h>
+
+Instruction decodeInstruction(uint16_t opcode){
+    uint8_t firstHexit =    (opcode & 0xF000) >> 12;
+    uint8_t fourthHexit =   (opcode & 0x000F);
+    uint8_t lsb =           (opcode & 0x00FF);
+
+    switch(firstHexit){
+        case 0x0:
+            if(opcode == 0x00EE){
+                return Instruction::RET;
+            }else if(opcode == 0x00E0){
+                return Instruction::CLS;
+            }
+            return Instruction::OEXE;
+        case 0x1: return Instruction::JUMP;
+        case 0x2: return Instruction::EXE;
+        case 0x3: return Instruction::SEI;
+        case 0x4: return Instruction::SNEI;
+        case 0x5: return Instruction::SE;
+        case 0x6: return Instruction::STRI;
+        case 0x7: return Instruction::ADDI;
+        case 0x8:
+            switch(fourthHexit){
+                case 0x0: return Instruction::COPY;
+                case 0x1: return Instruction::OR;
+                case 0x2: return Instruction::AND;
+                case 0x3: return Instruction::XOR;
+                case 0x4: return Instruction::ADD;
+                case 0x5: return Instruction::SUB;
+                case 0x6: return Instruction::RSH;
+                case 0x7: return Instruction::SUBR;
+                default:  return Instruction::LSH;
+            }
+        case 0x9: return Instruction::SNE;
+        case 0xA: return Instruction::STR;
+        case 0xB: return Instruction::BR;
+        case 0xC: return Instruction::RND;
+        case 0xD: return Instruction::DRAW;
+        case 0xE:
+            return (fourthHexit == 0xE)? Instruction::SP: Instruction::SNP;
+        default:
+            switch(lsb){
+                case 0x07: return Instruction::STRD;
+                case 0x0A: return Instruction::WAIT;
+                case 0x15: return Instruction::SETD;
+                case 0x18: return Instruction::SETS;
+                case 0x1E: return Instruction::OFFS;
+                case 0x29: return Instruction::NUM;
+                case 0x33: return Instruction::BCD;
+                case 0x55: return Instruction::STRM;
+                default:   return Instruction::LDM;
+            }
+    }
+}
+
+const char *getInstructionName(Instruction instruction){
+    static const char *names[] = {
+        "OEXE", "CLS", "RET", "JUMP", "EXE", "SEI", "SNEI", "SE", "STRI", "ADDI",
+        "COPY", "OR", "AND", "XOR", "ADD", "SUB", "RSH", "SUBR", "LSH", "SNE",
+        "STR", "BR", "RND", "DRAW", "SP", "SNP", "STRD", "WAIT", "SETD", "SETS",
+        "OFFS", "NUM", "BCD", "STRM", "LDM"
+    };
+
+    if(instruction >= Instruction::COUNT){
+        return "";
+    }
+    return names[(uint8_t) instruction];
+}
+
+std::string disassembleInstruction(uint16_t opcode){
+    Instruction instruction = decodeInstruction(opcode);
+    const char *name = getInstructionName(instruction);
+
+    unsigned registerX = (opcode & 0x0F00) >> 8;
+    unsigned registerY = (opcode & 0x00F0) >> 4;
+    unsigned address =   (opcode & 0x0FFF);
+    unsigned immediate = (opcode & 0x00FF);
+    unsigned nibble =    (opcode & 0x000F);
+
+    char text[32];
+    switch(instruction){
+        case Instruction::CLS:
+        case Instruction::RET:
+            snprintf(text, sizeof(text), "%s", name);
+            break;
+        case Instruction::OEXE:
+        case Instruction::JUMP:
+        case Instruction::EXE:
+        case Instruction::STR:
+        case Instruction::BR:
+            snprintf(text, sizeof(text), "%s 0x%03X", name, address);
+            break;
+        case Instruction::SEI:
+        case Instruction::SNEI:
+        case Instruction::STRI:
+        case Instruction::ADDI:
+        case Instruction::RND:
+            snprintf(text, sizeof(text), "%s V%X, 0x%02X", name, registerX, immediate);
+            break;
+        case Instruction::DRAW:
+            snprintf(text, sizeof(text), "%s V%X, V%X, 0x%X", name, registerX, registerY, nibble);
+            break;
+        case Instruction::SE:
+        case Instruction::COPY:
+        case Instruction::OR:
+        case Instruction::AND:
+        case Instruction::XOR:
+        case Instruction::ADD:
+        case Instruction::SUB:
+        case Instruction::RSH:
+        case Instruction::SUBR:
+        case Instruction::LSH:
+        case Instruction::SNE:
+            snprintf(text, sizeof(text), "%s V%X, V%X", name, registerX, registerY);
+            break;
+        default:
+            snprintf(text, sizeof(text), "%s V%X", name, registerX);
+            break;
+    }
+    return text;
+}
+
+bool isSkipInstruction(Instruction instruction){
+    switch(instruction){
+        case Instruction::SEI:
+        case Instruction::SNEI:
+        case Instruction::SE:
+        case Instruction::SNE:
+        case Instruction::SP:
+        case Instruction::SNP:
+            return true;
+        default:
+            return false;
+    }
+}
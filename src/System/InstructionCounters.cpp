@@ -0,0 +1,86 @@
+#include <ChipM8/System/InstructionCounters.h>
+
+#include <cstddef>
+
+InstructionCounters::InstructionCounters(){
+    reset();
+}
+
+void InstructionCounters::record(uint16_t opcode, uint16_t nextPC, uint16_t resultPC){
+    Instruction instruction = decodeInstruction(opcode);
+    counts[(uint8_t) instruction]++;
+
+    if(instruction == Instruction::DRAW){
+        spriteHeights[opcode & 0x000F]++;
+    }else if(isSkipInstruction(instruction) && resultPC != nextPC){
+        skipsTaken[(uint8_t) instruction]++;
+    }
+}
+
+uint64_t InstructionCounters::getCount(Instruction instruction){
+    return counts[(uint8_t) instruction];
+}
+
+uint64_t InstructionCounters::getSpriteHeightCount(uint8_t height){
+    return spriteHeights[height & 0x0F];
+}
+
+uint64_t InstructionCounters::getSkipCount(Instruction instruction, bool taken){
+    uint64_t skipped = skipsTaken[(uint8_t) instruction];
+    return taken? skipped: counts[(uint8_t) instruction] - skipped;
+}
+
+uint64_t InstructionCounters::getTotal(){
+    uint64_t total = 0;
+    for(std::size_t instruction = 0; instruction < (uint8_t) Instruction::COUNT; instruction++){
+        total += counts[instruction];
+    }
+    return total;
+}
+
+void InstructionCounters::reset(){
+    for(std::size_t instruction = 0; instruction < (uint8_t) Instruction::COUNT; instruction++){
+        counts[instruction] = 0;
+        skipsTaken[instruction] = 0;
+    }
+    for(std::size_t height = 0; height < 16; height++){
+        spriteHeights[height] = 0;
+    }
+}
+
+void InstructionCounters::writeJSON(std::ostream &out){
+    out << "{\n";
+    out << "  \"total\": " << getTotal() << ",\n";
+
+    // Executions per instruction
+    out << "  \"instructions\": {";
+    for(std::size_t index = 0; index < (uint8_t) Instruction::COUNT; index++){
+        Instruction instruction = (Instruction) index;
+        out << ((index == 0)? "\n": ",\n");
+        out << "    \"" << getInstructionName(instruction) << "\": " << counts[index];
+    }
+    out << "\n  },\n";
+
+    // DRAW executions per sprite height
+    out << "  \"spriteHeights\": [";
+    for(std::size_t height = 0; height < 16; height++){
+        out << ((height == 0)? "": ", ") << spriteHeights[height];
+    }
+    out << "],\n";
+
+    // Taken and not taken conditional skips
+    out << "  \"skips\": {";
+    bool first = true;
+    for(std::size_t index = 0; index < (uint8_t) Instruction::COUNT; index++){
+        Instruction instruction = (Instruction) index;
+        if(!isSkipInstruction(instruction)){
+            continue;
+        }
+        out << (first? "\n": ",\n");
+        out << "    \"" << getInstructionName(instruction) << "\": {\"taken\": " << getSkipCount(instruction, true)
+            << ", \"notTaken\": " << getSkipCount(instruction, false) << "}";
+        first = false;
+    }
+    out << "\n  }\n";
+    out << "}\n";
+}
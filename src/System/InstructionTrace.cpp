@@ -0,0 +1,127 @@
+#include <ChipM8/System/InstructionTrace.h>
+
+#include <algorithm>
+#include <fstream>
+
+static const char TRACE_MAGIC[4] = {'C', '8', 'T', 'R'};
+static const uint16_t TRACE_VERSION = 1;
+static const uint16_t TRACE_RECORD_SIZE = 8;
+
+static void writeLittleEndian(std::ostream &out, uint64_t value, std::size_t bytes){
+    for(std::size_t byte = 0; byte < bytes; byte++){
+        out.put((char) ((value >> (byte * 8)) & 0xFF));
+    }
+}
+
+static uint64_t readLittleEndian(std::istream &in, std::size_t bytes){
+    uint64_t value = 0;
+    for(std::size_t byte = 0; byte < bytes; byte++){
+        value |= ((uint64_t) (uint8_t) in.get()) << (byte * 8);
+    }
+    return value;
+}
+
+InstructionTrace::InstructionTrace(std::size_t capacity){
+    // Round the capacity up to a power of 2 for cheap wrapping
+    std::size_t size = 1;
+    while(size < capacity){
+        size <<= 1;
+    }
+
+    records.resize(size);
+    mask = size - 1;
+    recorded = 0;
+
+    trigger = {0, 0, 0, 0};
+    armed = false;
+    triggered = false;
+}
+
+void InstructionTrace::armTrigger(TraceTrigger trigger, std::string path){
+    this->trigger = trigger;
+    triggerPath = path;
+    armed = true;
+    triggered = false;
+}
+
+void InstructionTrace::disarmTrigger(){
+    armed = false;
+}
+
+bool InstructionTrace::hasTriggered(){
+    return triggered;
+}
+
+void InstructionTrace::fireTrigger(){
+    armed = false;
+    triggered = true;
+    flush(triggerPath);
+}
+
+bool InstructionTrace::flush(std::string path){
+    std::ofstream traceFile(path, std::ios_base::binary);
+    if(!traceFile.good()){
+        return false;
+    }
+
+    // Header
+    traceFile.write(TRACE_MAGIC, sizeof(TRACE_MAGIC));
+    writeLittleEndian(traceFile, TRACE_VERSION, 2);
+    writeLittleEndian(traceFile, TRACE_RECORD_SIZE, 2);
+    writeLittleEndian(traceFile, size(), 8);
+
+    // Records, oldest first
+    for(std::size_t index = 0; index < size(); index++){
+        TraceRecord record = getRecord(index);
+        writeLittleEndian(traceFile, record.PC, 2);
+        writeLittleEndian(traceFile, record.opcode, 2);
+        writeLittleEndian(traceFile, record.I, 2);
+        writeLittleEndian(traceFile, record.VX, 1);
+        writeLittleEndian(traceFile, record.VF, 1);
+    }
+
+    return traceFile.good();
+}
+
+std::size_t InstructionTrace::size(){
+    return (recorded < records.size())? (std::size_t) recorded: records.size();
+}
+
+TraceRecord InstructionTrace::getRecord(std::size_t index){
+    uint64_t oldest = recorded - size();
+    return records[(oldest + index) & mask];
+}
+
+void InstructionTrace::clear(){
+    recorded = 0;
+}
+
+bool InstructionTrace::read(std::string path, std::vector<TraceRecord> &records){
+    std::ifstream traceFile(path, std::ios_base::binary);
+
+    char magic[4];
+    traceFile.read(magic, sizeof(magic));
+    uint16_t version = readLittleEndian(traceFile, 2);
+    uint16_t recordSize = readLittleEndian(traceFile, 2);
+    uint64_t count = readLittleEndian(traceFile, 8);
+
+    if(!traceFile.good() || !std::equal(magic, magic + 4, TRACE_MAGIC) || version != TRACE_VERSION || recordSize != TRACE_RECORD_SIZE){
+        return false;
+    }
+
+    records.clear();
+    for(uint64_t index = 0; index < count; index++){
+        TraceRecord record;
+        record.PC = readLittleEndian(traceFile, 2);
+        record.opcode = readLittleEndian(traceFile, 2);
+        record.I = readLittleEndian(traceFile, 2);
+        record.VX = readLittleEndian(traceFile, 1);
+        record.VF = readLittleEndian(traceFile, 1);
+        if(!traceFile.good()){
+            return false;
+        }
+        records.push_back(record);
+    }
+
+    return true;
+}
@@ -1,183 +1,126 @@
 #include <ChipM8/System/Interpreter.h>
+#include <ChipM8/System/StateHash.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 
-#include <stdlib.h>
-#include <time.h>
-
-void setHexDigits(Memory &memory){
-
-    int hexDigit = 0;
-    uint16_t addressOffset = hexDigit * 5;
-    memory[0 + addressOffset] = 0xF0;
-    memory[1 + addressOffset] = 0x90;
-    memory[2 + addressOffset] = 0x90;
-    memory[3 + addressOffset] = 0x90;
-    memory[4 + addressOffset] = 0xF0;
-
-    hexDigit = 1;
-    addressOffset = hexDigit * 5;
-    memory[0 + addressOffset] = 0x20;
-    memory[1 + addressOffset] = 0x60;
-    memory[2 + addressOffset] = 0x20;
-    memory[3 + addressOffset] = 0x20;
-    memory[4 + addressOffset] = 0x70;
-    
-    hexDigit = 2;
-    addressOffset = hexDigit * 5;
-    memory[0 + addressOffset] = 0xF0;
-    memory[1 + addressOffset] = 0x10;
-    memory[2 + addressOffset] = 0xF0;
-    memory[3 + addressOffset] = 0x80;
-    memory[4 + addressOffset] = 0xF0;
-    
-    hexDigit = 3;
-    addressOffset = hexDigit * 5;
-    memory[0 + addressOffset] = 0xF0;
-    memory[1 + addressOffset] = 0x10;
-    memory[2 + addressOffset] = 0xF0;
-    memory[3 + addressOffset] = 0x10;
-    memory[4 + addressOffset] = 0xF0;
-    
-    hexDigit = 4;
-    addressOffset = hexDigit * 5;
-    memory[0 + addressOffset] = 0x90;
-    memory[1 + addressOffset] = 0x90;
-    memory[2 + addressOffset] = 0xF0;
-    memory[3 + addressOffset] = 0x10;
-    memory[4 + addressOffset] = 0x10;
-    
-    hexDigit = 5;
-    addressOffset = hexDigit * 5;
-    memory[0 + addressOffset] = 0xF0;
-    memory[1 + addressOffset] = 0x80;
-    memory[2 + addressOffset] = 0xF0;
-    memory[3 + addressOffset] = 0x10;
-    memory[4 + addressOffset] = 0xF0;
-
-    hexDigit = 6;
-    addressOffset = hexDigit * 5;
-    memory[0 + addressOffset] = 0xF0;
-    memory[1 + addressOffset] = 0x80;
-    memory[2 + addressOffset] = 0xF0;
-    memory[3 + addressOffset] = 0x90;
-    memory[4 + addressOffset] = 0xF0;
-    
-    hexDigit = 7;
-    addressOffset = hexDigit * 5;
-    memory[0 + addressOffset] = 0xF0;
-    memory[1 + addressOffset] = 0x10;
-    memory[2 + addressOffset] = 0x20;
-    memory[3 + addressOffset] = 0x40;
-    memory[4 + addressOffset] = 0x40;
-    
-    hexDigit = 8;
-    addressOffset = hexDigit * 5;
-    memory[0 + addressOffset] = 0xF0;
-    memory[1 + addressOffset] = 0x90;
-    memory[2 + addressOffset] = 0xF0;
-    memory[3 + addressOffset] = 0x90;
-    memory[4 + addressOffset] = 0xF0;
-    
-    hexDigit = 9;
-    addressOffset = hexDigit * 5;
-    memory[0 + addressOffset] = 0xF0;
-    memory[1 + addressOffset] = 0x90;
-    memory[2 + addressOffset] = 0xF0;
-    memory[3 + addressOffset] = 0x10;
-    memory[4 + addressOffset] = 0xF0;
-    
-    hexDigit = 0xA;
-    addressOffset = hexDigit * 5;
-    memory[0 + addressOffset] = 0xF0;
-    memory[1 + addressOffset] = 0x90;
-    memory[2 + addressOffset] = 0xF0;
-    memory[3 + addressOffset] = 0x90;
-    memory[4 + addressOffset] = 0x90;
-    
-    hexDigit = 0xB;
-    addressOffset = hexDigit * 5;
-    memory[0 + addressOffset] = 0xE0;
-    memory[1 + addressOffset] = 0x90;
-    memory[2 + addressOffset] = 0xE0;
-    memory[3 + addressOffset] = 0x90;
-    memory[4 + addressOffset] = 0xE0;
-    
-    hexDigit = 0xC;
-    addressOffset = hexDigit * 5;
-    memory[0 + addressOffset] = 0xF0;
-    memory[1 + addressOffset] = 0x80;
-    memory[2 + addressOffset] = 0x80;
-    memory[3 + addressOffset] = 0x80;
-    memory[4 + addressOffset] = 0xF0;
-    
-    hexDigit = 0xD;
-    addressOffset = hexDigit * 5;
-    memory[0 + addressOffset] = 0xE0;
-    memory[1 + addressOffset] = 0x90;
-    memory[2 + addressOffset] = 0x90;
-    memory[3 + addressOffset] = 0x90;
-    memory[4 + addressOffset] = 0xE0;
-    
-    hexDigit = 0xE;
-    addressOffset = hexDigit * 5;
-    memory[0 + addressOffset] = 0xF0;
-    memory[1 + addressOffset] = 0x80;
-    memory[2 + addressOffset] = 0xF0;
-    memory[3 + addressOffset] = 0x80;
-    memory[4 + addressOffset] = 0xF0;
-    
-    hexDigit = 0xF;
-    addressOffset = hexDigit * 5;
-    memory[0 + addressOffset] = 0xF0;
-    memory[1 + addressOffset] = 0x80;
-    memory[2 + addressOffset] = 0xF0;
-    memory[3 + addressOffset] = 0x80;
-    memory[4 + addressOffset] = 0x80;
+
+static const uint32_t NO_ADDRESS = 0x10000; // resumeAddress when not resuming from a stop
+
+/**
+ * The hexadecimal digit sprites, 5 bytes each
+ **/
+static constexpr uint8_t FONT[] = {
+    0xF0, 0x90, 0x90, 0x90, 0xF0, // 0
+    0x20, 0x60, 0x20, 0x20, 0x70, // 1
+    0xF0, 0x10, 0xF0, 0x80, 0xF0, // 2
+    0xF0, 0x10, 0xF0, 0x10, 0xF0, // 3
+    0x90, 0x90, 0xF0, 0x10, 0x10, // 4
+    0xF0, 0x80, 0xF0, 0x10, 0xF0, // 5
+    0xF0, 0x80, 0xF0, 0x90, 0xF0, // 6
+    0xF0, 0x10, 0x20, 0x40, 0x40, // 7
+    0xF0, 0x90, 0xF0, 0x90, 0xF0, // 8
+    0xF0, 0x90, 0xF0, 0x10, 0xF0, // 9
+    0xF0, 0x90, 0xF0, 0x90, 0x90, // A
+    0xE0, 0x90, 0xE0, 0x90, 0xE0, // B
+    0xF0, 0x80, 0x80, 0x80, 0xF0, // C
+    0xE0, 0x90, 0x90, 0x90, 0xE0, // D
+    0xF0, 0x80, 0xF0, 0x80, 0xF0, // E
+    0xF0, 0x80, 0xF0, 0x80, 0x80  // F
+};
+
+/**
+ * The memory an Interpreter boots with, the font followed by zeros
+ **/
+static constexpr MemoryImage createBootImage(){
+    MemoryImage image{};
+    for(std::size_t byte = 0; byte < sizeof(FONT); byte++){
+        image.data[byte] = FONT[byte];
+    }
+    return image;
+}
+
+static constexpr MemoryImage BOOT_IMAGE = createBootImage();
+
+/**
+ * Returns the boot image, built at compile time and never freed
+ **/
+static const std::shared_ptr<const MemoryImage> &getBootImage(){
+    static const std::shared_ptr<const MemoryImage> image(&BOOT_IMAGE, [](const MemoryImage *){});
+    return image;
+}
+
+/**
+ * Returns a seed differing between Interpreters
+ **/
+static uint64_t createSeed(){
+    static std::atomic<uint64_t> instances(0);
+    uint64_t now = std::chrono::steady_clock::now().time_since_epoch().count();
+    return mixHash(now ^ mixHash(instances++));
 }
 
 Interpreter::Interpreter(){
-    // The program counter should start at 0x200
-    registers.PC = 0x200;
+    timingModel = TimingModel::Instruction;
+    displayWait = false;
 
-    // The stack pointer should point to 0x200
-    registers.SP = 0x200;
+    trace = nullptr;
+    profiler = nullptr;
 
-    // Set all other pointers to 0
-    for(std::size_t registerNumber = 0; registerNumber < 16; registerNumber++){
-        registers.V[registerNumber] = 0;
-    }
+    hashValidation = false;
+    hashMismatches = 0;
 
-    // Set the screen to all clear
-    screen.clear();
+    fusion = false;
+    resetFusionCounts();
 
-    registers.DT = 0;
-    registers.ST = 0;
+    nativeProgram = nullptr;
+    nativeContext = NativeContext{&registers, this, &Interpreter::executeNative};
+    nativeInstructions = 0;
 
-    setHexDigits(memory);
+    cyclesPerTimerTick = 0;
+    watchHit = WatchHit{0, 0, Watch::Read, 0};
+    stopCycle = 0;
+    stepping = false;
+    stepAddress = 0;
+    stepSP = 0;
+    singleStep = false;
 
-    // Set the random seed
-    srand(time(nullptr));
+    // Boot with the font, shared with every other Interpreter
+    reset(getBootImage(), createSeed());
 }
 
 Interpreter::~Interpreter(){
 
 }
 
-uint16_t fetchOpcode(Memory &memory, Registers &registers){
-    uint16_t opcode = memory[registers.PC] << 8;
-    opcode += memory[registers.PC+1];
+uint16_t fetchOpcode(Memory &memory, uint16_t address){
+    uint16_t opcode = memory.fetch(address) << 8;
+    opcode += memory.fetch(address+1);
     return opcode;
 }
 
+uint16_t fetchOpcode(Memory &memory, Registers &registers){
+    return fetchOpcode(memory, registers.PC);
+}
+
 void CLS(Screen &screen){
     screen.clear();
 }
 
 void RET(Registers &registers, Memory &memory){
-    uint8_t addressUpper = memory[registers.SP+0];
-    uint8_t addressLower = memory[registers.SP+1];
+    uint8_t addressUpper;
+    uint8_t addressLower;
+    const uint8_t *stack = memory.loadRun(registers.SP, 2);
+    if(stack != nullptr){
+        addressUpper = stack[0];
+        addressLower = stack[1];
+    }else{
+        addressUpper = memory.load(registers.SP+0);
+        addressLower = memory.load(registers.SP+1);
+    }
 
     uint16_t address = (addressUpper << 8) + addressLower;
 
@@ -195,8 +138,14 @@ void EXE(Registers &registers, Memory &memory, uint16_t address){
 
     registers.SP -= 2;
 
-    memory[registers.SP+0] = pcUpper;
-    memory[registers.SP+1] = pcLower;
+    uint8_t *stack = memory.writeRun(registers.SP, 2);
+    if(stack != nullptr){
+        stack[0] = pcUpper;
+        stack[1] = pcLower;
+    }else{
+        memory.write(registers.SP+0, pcUpper);
+        memory.write(registers.SP+1, pcLower);
+    }
 
     registers.PC = address;
 }
@@ -285,10 +234,11 @@ void BR(Registers &registers, uint16_t address){
     registers.PC = ((address + registers.V[0]) % 0x1000);
 }
 
-void RND(Registers &registers, uint8_t registerX, uint8_t immediate){
-    
-    // Generate a random number with that can fit in one byte register
-    uint8_t randomValue = rand() % 0x100;
+void RND(Registers &registers, uint64_t &randomState, uint8_t registerX, uint8_t immediate){
+
+    // Each Interpreter has its own generator (splitmix64), so runs are reproducible
+    randomState += 0x9E3779B97F4A7C15ull;
+    uint8_t randomValue = mixHash(randomState) >> 56;
 
     // Set registerX to be the random value AND'd with the immediate mask
     registers.V[registerX] = randomValue & immediate;
@@ -306,7 +256,7 @@ void DRAW(Registers &registers, Memory &memory, Screen &screen, uint8_t register
     for(std::size_t byte = 0; byte < nibble; byte++){
 
         // Get sprite data
-        uint8_t data = memory[registers.I + byte];
+        uint8_t data = memory.load(registers.I + byte);
 
         // Iterate through each of the pixels
         for(std::size_t pixel = 0; pixel < 8; pixel++){
@@ -345,6 +295,10 @@ void SNP(Registers &registers, Input &input, uint8_t registerX){
     }
 }
 
+uint8_t remainingTimerTicks(uint64_t expiry, uint64_t now){
+    return (expiry > now)? (uint8_t) (expiry - now): 0;
+}
+
 void STRD(Registers &registers, uint8_t registerX){
     registers.V[registerX] = registers.DT;
 }
@@ -377,20 +331,36 @@ void BCD(Registers &registers, Memory &memory, uint8_t registerX){
     int secondDigit = ((registerValue % 100) - (registerValue % 10)) / 10;
     int thirdDigit = registerValue % 10;
 
-    memory[registers.I+0] = firstDigit;
-    memory[registers.I+1] = secondDigit;
-    memory[registers.I+2] = thirdDigit;
+    memory.write(registers.I+0, firstDigit);
+    memory.write(registers.I+1, secondDigit);
+    memory.write(registers.I+2, thirdDigit);
 }
 
 void STRM(Registers &registers, Memory &memory, uint8_t registerX){
+    uint8_t *data = memory.writeRun(registers.I, registerX + 1);
+    if(data != nullptr){
+        for(std::size_t registerNum = 0; registerNum <= registerX; registerNum++){
+            data[registerNum] = registers.V[registerNum];
+        }
+        return;
+    }
+
     for(std::size_t registerNum = 0; (uint8_t) registerNum < (registerX+1); registerNum++){
-        memory[registers.I + registerNum] = registers.V[registerNum];
+        memory.write(registers.I + registerNum, registers.V[registerNum]);
     }
 }
 
 void LDM(Registers &registers, Memory &memory, uint8_t registerX){
+    const uint8_t *data = memory.loadRun(registers.I, registerX + 1);
+    if(data != nullptr){
+        for(std::size_t registerNum = 0; registerNum <= registerX; registerNum++){
+            registers.V[registerNum] = data[registerNum];
+        }
+        return;
+    }
+
     for(std::size_t registerNum = 0; (uint8_t) registerNum < (registerX+1); registerNum++){
-        registers.V[registerNum] = memory[registers.I + registerNum];
+        registers.V[registerNum] = memory.load(registers.I + registerNum);
     }
 }
 
@@ -415,6 +385,9 @@ void Interpreter::executeInstruction(uint16_t opcode){
             }else if(opcode == 0x00E0){
                 // CLS
                 CLS(screen);
+            }else if((opcode >> 8) == Memory::TRAP_BYTE) [[unlikely]] {
+                // OEXE, unless fetched in place of a trapped instruction
+                trap();
             }else{
                 // OEXE
             }
@@ -501,11 +474,14 @@ void Interpreter::executeInstruction(uint16_t opcode){
             break;
         case 0xC:
             // RND
-            RND(registers, registerX, immediate);
+            RND(registers, randomState, registerX, immediate);
             break;
         case 0xD:
             // DRAW
             DRAW(registers, memory, screen, registerX, registerY, nibble);
+            if(displayWait) [[unlikely]] {
+                startDisplayWait();
+            }
             break;
         case 0xE:
             if(fourthHexit == 0xE){
@@ -520,6 +496,7 @@ void Interpreter::executeInstruction(uint16_t opcode){
             switch(lsb){
                 case 0x07:
                     // STRD
+                    getDelayTimer();
                     STRD(registers, registerX);
                     break;
                 case 0x0A:
@@ -529,10 +506,12 @@ void Interpreter::executeInstruction(uint16_t opcode){
                 case 0x15:
                     // SETD
                     SETD(registers, registerX);
+                    setDelayTimer(registers.DT);
                     break;
                 case 0x18:
                     // SETS
                     SETS(registers, registerX);
+                    setSoundTimer(registers.ST);
                     break;
                 case 0x1E:
                     // OFFS
@@ -561,34 +540,712 @@ void Interpreter::executeInstruction(uint16_t opcode){
 
 void Interpreter::tick(){
 
+    // Nothing can execute until the waited key is delivered, or the display is drawn
+    if(hasExecutionHalted() || cycleCount < displayWaitCycle){
+        cycleCount++;
+        return;
+    }
 
     // First we need to fetch the opcode
+    uint16_t pc = registers.PC;
     uint16_t opcode = fetchOpcode(memory, registers);
+
+    // A trap is timed and observed as the instruction it replaced
+    uint16_t instruction = opcode;
+    if((opcode >> 8) == Memory::TRAP_BYTE){
+        instruction = (memory.read(pc) << 8) | memory.read(pc + 1);
+    }
+
+    uint32_t cycles = 1;
+    if(timingModel == TimingModel::VIP){
+        cycles = getVipCycles(instruction, registers);
+    }
     
     // Increment the program counter for the next instruction
     registers.PC += 2;
     registers.PC = registers.PC % 0x1000;
 
+#ifdef CHIPM8_INSTRUMENTATION
+    uint16_t nextPC = registers.PC;
+#endif
+
     // Execute the instruction
     executeInstruction(opcode);
+    if(trapped){
+        // Stopped on a breakpoint before executing it
+        trapped = false;
+        return;
+    }
+    cycleCount += cycles;
+
+    if(memory.hasWatchHit()){
+        watchHit = memory.getWatchHit();
+        watchHit.pc = pc;
+        memory.clearWatchHit();
+        stopReason = StopReason::Watchpoint;
+        stopCycle = 0;
+    }
+
+    if(trace != nullptr){
+        trace->record(pc, instruction, registers);
+    }
+
+    if(profiler != nullptr){
+        profiler->record(pc, instruction, cycles);
+    }
+
+#ifdef CHIPM8_INSTRUMENTATION
+    counters.record(instruction, nextPC, registers.PC);
+#endif
+}
+
+std::size_t Interpreter::run(std::size_t cycles){
+    // Cycles the last run's final instruction ran over come out of this budget
+    uint64_t owed = std::min<uint64_t>(cycleOvershoot, cycles);
+    cycleOvershoot -= owed;
+    uint64_t endCycle = cycleCount + cycles - owed;
+
+    std::size_t executed = 0;
+    stopReason = StopReason::None;
+
+    // Breakpoints trap when fetched, so cost nothing until reached
+    if(memory.hasTraps()){
+        memory.refreshTraps();
+    }
+#ifndef CHIPM8_INSTRUMENTATION
+    // Native code neither traps nor waits for the display
+    NativeProgram *native = nativeProgram;
+    if(memory.hasTraps() || displayWait){
+        native = nullptr;
+    }
+#endif
+    if(registers.PC != resumeAddress){
+        resumeAddress = NO_ADDRESS;
+    }
+
+    // A DRAW waiting for the display leaves the loops below until the next frame
+    bool running = waitForDisplay(endCycle);
+    while(running){
+        // Stopping sets stopCycle to 0 to leave the loops below
+        stopCycle = endCycle;
+        if(singleStep){
+            stopCycle = std::min<uint64_t>(endCycle, cycleCount + 1);
+        }
+
+#ifndef CHIPM8_INSTRUMENTATION
+        if((fusion || native != nullptr) && timingModel == TimingModel::Instruction && trace == nullptr && profiler == nullptr && !memory.hasWatchpoints()){
+            while(cycleCount < stopCycle && !hasExecutionHalted()){
+                uint64_t instructions = 0;
+                if(native != nullptr){
+                    instructions = executeNativeBlock(stopCycle - cycleCount);
+                    if(instructions != 0){
+                        cycleCount += instructions;
+                        executed += instructions;
+                        continue;
+                    }
+                }
+
+                uint16_t opcode = fetchOpcode(memory, registers);
+                if(fusion){
+                    instructions = executeFused(opcode, stopCycle - cycleCount);
+                }
+                if(instructions == 0){
+                    registers.PC += 2;
+                    registers.PC = registers.PC % 0x1000;
+                    executeInstruction(opcode);
+                    instructions = 1;
+                }
+
+                cycleCount += instructions;
+                executed += instructions;
+            }
+
+            // The trapped instruction was counted but not executed
+            if(trapped){
+                trapped = false;
+                cycleCount--;
+                executed--;
+            }
+        }
+#endif
+
+        // Every instruction is observed when neither fusing nor running native code
+        while(cycleCount < stopCycle && !hasExecutionHalted()){
+            // A trapped tick executes nothing
+            uint64_t cycle = cycleCount;
+            tick();
+            executed += (cycleCount != cycle);
+        }
+
+        running = cycleCount < displayWaitCycle && stopReason == StopReason::None && !singleStep && waitForDisplay(endCycle);
+    }
+
+    if(singleStep && stopReason == StopReason::None && executed != 0){
+        singleStep = false;
+        stopReason = StopReason::Step;
+    }
+
+    // A halted Interpreter waits out the remaining cycles, a stopped one returns at once
+    if(stopReason == StopReason::None){
+        if(cycleCount > endCycle){
+            cycleOvershoot += cycleCount - endCycle;
+        }else{
+            cycleCount = endCycle;
+        }
+    }
+
+    speaker.render(cycleCount);
+    return executed;
+}
+
+uint64_t Interpreter::executeFused(uint16_t opcode, uint64_t cycles){
+    uint16_t pc = registers.PC;
+
+    // Sequences wrapping around the end of memory are not fused
+    if(pc > 0xFFA || cycles < 2){
+        return 0;
+    }
+
+    uint8_t registerX = (opcode & 0x0F00) >> 8;
+    uint8_t lsb = (opcode & 0x00FF);
+
+    switch(opcode >> 12){
+        case 0x6:{
+            // STRI VX, NN; STRI VY, NN; DRAW VX, VY, N
+            uint16_t second = fetchOpcode(memory, pc + 2);
+            if((second & 0xF000) != 0x6000 || cycles < 3){
+                return 0;
+            }
+            uint8_t registerY = (second & 0x0F00) >> 8;
+            uint16_t third = fetchOpcode(memory, pc + 4);
+            if((third & 0xFFF0) != (0xD000 | (registerX << 8) | (registerY << 4))){
+                return 0;
+            }
+
+            registers.V[registerX] = lsb;
+            registers.V[registerY] = (second & 0x00FF);
+            registers.PC = pc + 6;
+            DRAW(registers, memory, screen, registerX, registerY, third & 0x000F);
+            if(displayWait){
+                startDisplayWait();
+            }
+            return countFusion(Fusion::PositionDraw, 3);
+        }
+        case 0xA:{
+            // STR NNN; OFFS VX
+            uint16_t second = fetchOpcode(memory, pc + 2);
+            if((second & 0xF0FF) != 0xF01E){
+                return 0;
+            }
+
+            registers.I = (opcode & 0x0FFF);
+            OFFS(registers, (second & 0x0F00) >> 8);
+            registers.PC = pc + 4;
+            return countFusion(Fusion::IndexOffset, 2);
+        }
+        case 0x7:{
+            // ADDI VX, 0x01; SEI VX, NN; JUMP back, until VX reaches NN
+            if(lsb != 0x01 || cycles < 3){
+                return 0;
+            }
+            uint16_t second = fetchOpcode(memory, pc + 2);
+            if((second & 0xFF00) != (0x3000 | (registerX << 8)) || fetchOpcode(memory, pc + 4) != (0x1000 | pc)){
+                return 0;
+            }
+
+            // Iterations that jump back, within the cycles left
+            uint8_t target = (second & 0x00FF);
+            uint64_t iterations = (uint8_t) (target - registers.V[registerX] - 1);
+            iterations = std::min<uint64_t>(iterations, cycles / 3);
+            if(iterations == 0){
+                return 0;
+            }
+
+            registers.V[registerX] += (uint8_t) iterations;
+            return countFusion(Fusion::CountedLoop, iterations * 3);
+        }
+        case 0xF:{
+            // STRD VX; SEI VX, 0x00; JUMP back, until the delay timer expires
+            if(lsb != 0x07 || cycles < 6){
+                return 0;
+            }
+            if(fetchOpcode(memory, pc + 2) != (0x3000 | (registerX << 8)) || fetchOpcode(memory, pc + 4) != (0x1000 | pc)){
+                return 0;
+            }
+
+            uint8_t delay = getDelayTimer();
+            if(delay == 0){
+                return 0;
+            }
+
+            // Iterations reading a non zero delay timer, within the cycles left
+            uint64_t iterations = cycles / 3;
+            if(cyclesPerTimerTick != 0){
+                uint64_t expiryCycle = delayExpiry * cyclesPerTimerTick;
+                iterations = std::min<uint64_t>(iterations, (expiryCycle - cycleCount + 2) / 3);
+            }
+
+            // The last iteration executes normally, leaving VX and DT as it would
+            if(iterations < 2){
+                return 0;
+            }
+            return countFusion(Fusion::TimerPoll, (iterations - 1) * 3);
+        }
+    }
+
+    return 0;
+}
+
+uint64_t Interpreter::executeNativeBlock(uint64_t cycles){
+    const NativeBlock *block = nativeProgram->getBlock(registers.PC);
+    if(block == nullptr || block->length > cycles || !nativeProgram->isUnmodified(*block, memory)){
+        return 0;
+    }
+
+    uint32_t instructions = block->function(nativeContext);
+    nativeInstructions += instructions;
+    return instructions;
+}
+
+void Interpreter::executeNative(Interpreter *interpreter, uint16_t opcode, uint32_t offset){
+    // The cycle count is only advanced once the block returns
+    uint64_t cycle = interpreter->cycleCount;
+    interpreter->cycleCount += offset;
+    interpreter->executeInstruction(opcode);
+    interpreter->cycleCount = cycle;
+}
+
+void Interpreter::trap(){
+    uint16_t pc = (registers.PC + 0xFFE) % 0x1000;
+    if(!memory.isTrap(pc)){
+        return;
+    }
+
+    // Continuing from a stop executes the instruction stopped on
+    bool resuming = (pc == resumeAddress);
+    resumeAddress = NO_ADDRESS;
+    if(!resuming){
+        if(stepping && pc == stepAddress && registers.SP == stepSP){
+            stopAt(pc, StopReason::Step);
+            return;
+        }
+
+        auto breakpoint = breakpoints.find(pc);
+        if(breakpoint != breakpoints.end() && (!breakpoint->second || breakpoint->second(registers))){
+            stopAt(pc, StopReason::Breakpoint);
+            return;
+        }
+    }
+
+    // Not stopping, execute the instruction the trap replaced
+    uint16_t opcode = (memory.read(pc) << 8) | memory.read(pc + 1);
+    if((opcode >> 8) != Memory::TRAP_BYTE){
+        executeInstruction(opcode);
+    }
+}
+
+void Interpreter::stopAt(uint16_t pc, StopReason reason){
+    registers.PC = pc;
+    stopReason = reason;
+    stopCycle = 0;
+    trapped = true;
+    resumeAddress = pc;
+    if(reason == StopReason::Step){
+        cancelStep();
+    }
+}
+
+void Interpreter::armStep(uint16_t address, uint16_t sp){
+    stepping = true;
+    stepAddress = address;
+    stepSP = sp;
+    memory.setTrap(address);
+}
+
+uint64_t Interpreter::countFusion(Fusion fusion, uint64_t instructions){
+    fusionCounts[(std::size_t) fusion]++;
+    fusedInstructions[(std::size_t) fusion] += instructions;
+    return instructions;
 }
 
 void Interpreter::tickTimers(){
-   
-    if(registers.DT > 0){
-        registers.DT--;
+
+    if(cyclesPerTimerTick == 0){
+        hostTimerTicks++;
+
+        // The ticks are the frames a DRAW waits for
+        displayWaitCycle = 0;
+
+        // The tone stops as soon as the sound timer runs out
+        if(soundExpiry == hostTimerTicks){
+            speaker.setTone(false, cycleCount);
+        }
+    }
+
+    getDelayTimer();
+    getSoundTimer();
+
+    speaker.render(cycleCount);
+}
+
+uint64_t Interpreter::timerClock(){
+    if(cyclesPerTimerTick != 0){
+        return cycleCount / cyclesPerTimerTick;
+    }
+    return hostTimerTicks;
+}
+
+void Interpreter::setCyclesPerTimerTick(uint32_t cycles){
+    // Carry the current timer values over to the new clock
+    uint8_t delay = getDelayTimer();
+    uint8_t sound = getSoundTimer();
+
+    cyclesPerTimerTick = cycles;
+
+    setDelayTimer(delay);
+    setSoundTimer(sound);
+}
+
+uint8_t Interpreter::getDelayTimer(){
+    registers.DT = remainingTimerTicks(delayExpiry, timerClock());
+    return registers.DT;
+}
+
+uint8_t Interpreter::getSoundTimer(){
+    registers.ST = remainingTimerTicks(soundExpiry, timerClock());
+    return registers.ST;
+}
+
+void Interpreter::setDelayTimer(uint8_t value){
+    registers.DT = value;
+    delayExpiry = timerClock() + value;
+}
+
+void Interpreter::setSoundTimer(uint8_t value){
+    registers.ST = value;
+    soundExpiry = timerClock() + value;
+
+    // With cycle derived timers the tone's end is already known
+    uint64_t toneEnd = (cyclesPerTimerTick != 0)? soundExpiry * cyclesPerTimerTick: UINT64_MAX;
+    speaker.setTone(value > 0, cycleCount, toneEnd);
+}
+
+void Interpreter::setTrace(InstructionTrace *trace){
+    this->trace = trace;
+}
+
+void Interpreter::setProfiler(Profiler *profiler){
+    this->profiler = profiler;
+    if(profiler != nullptr){
+        profiler->synchronize(memory, registers);
+    }
+}
+
+void Interpreter::saveSnapshot(Snapshot &snapshot){
+    static std::atomic<uint64_t> nextSnapshotID(1);
+
+    snapshot.registers = registers;
+    snapshot.screen = screen;
+    snapshot.input = input.getState();
+    memory.saveState(snapshot.memory);
+
+    snapshot.cycleCount = cycleCount;
+    snapshot.cycleOvershoot = cycleOvershoot;
+    snapshot.randomState = randomState;
+    snapshot.displayWaitCycle = displayWaitCycle;
+    snapshot.cyclesPerTimerTick = cyclesPerTimerTick;
+    snapshot.hostTimerTicks = hostTimerTicks;
+    snapshot.delayExpiry = delayExpiry;
+    snapshot.soundExpiry = soundExpiry;
+
+    snapshot.id = nextSnapshotID.fetch_add(1, std::memory_order_relaxed);
+    memory.clearWrittenPages();
+    memorySnapshot = snapshot.id;
+}
+
+void Interpreter::restoreSnapshot(const Snapshot &snapshot){
+    // Nothing has been saved into the snapshot
+    if(snapshot.id == 0){
+        return;
+    }
+
+    registers = snapshot.registers;
+    screen = snapshot.screen;
+    input.setState(snapshot.input, registers);
+
+    // Only the pages written since differ from the snapshot last saved or restored
+    memory.restoreState(snapshot.memory, snapshot.id == memorySnapshot);
+    memory.clearWrittenPages();
+    memorySnapshot = snapshot.id;
+
+    cycleCount = snapshot.cycleCount;
+    cycleOvershoot = snapshot.cycleOvershoot;
+    randomState = snapshot.randomState;
+    displayWaitCycle = snapshot.displayWaitCycle;
+    cyclesPerTimerTick = snapshot.cyclesPerTimerTick;
+    hostTimerTicks = snapshot.hostTimerTicks;
+    delayExpiry = snapshot.delayExpiry;
+    soundExpiry = snapshot.soundExpiry;
+
+    // Continue the sample stream from the restored cycle with the restored tone
+    speaker.reset(cycleCount);
+    if(getSoundTimer() > 0){
+        uint64_t toneEnd = (cyclesPerTimerTick != 0)? soundExpiry * cyclesPerTimerTick: UINT64_MAX;
+        speaker.setTone(true, cycleCount, toneEnd);
+    }
+}
+
+void Interpreter::reset(std::shared_ptr<const MemoryImage> image, uint64_t seed){
+    registers = Registers{};
+    registers.PC = 0x200;
+    registers.SP = 0x200;
+    screen.clear();
+    input.setState(InputState{}, registers);
+
+    // Pages are shared with the image again, private storage is kept for reuse
+    memory.setImage(std::move(image));
+    memory.clearWatchHit();
+    memorySnapshot = 0;
+    randomState = seed;
+
+    cycleCount = 0;
+    cycleOvershoot = 0;
+    displayWaitCycle = 0;
+    hostTimerTicks = 0;
+    delayExpiry = 0;
+    soundExpiry = 0;
+    speaker.reset(cycleCount);
+
+    stopReason = StopReason::None;
+    trapped = false;
+    resumeAddress = NO_ADDRESS;
+    cancelStep();
+}
+
+std::shared_ptr<const MemoryImage> Interpreter::createImage(const uint8_t *program, std::size_t size){
+    std::shared_ptr<MemoryImage> image = std::make_shared<MemoryImage>(BOOT_IMAGE);
+    std::memcpy(image->data + 0x200, program, std::min<std::size_t>(size, 0x1000 - 0x200));
+    return image;
+}
+
+void Interpreter::setRandomSeed(uint64_t seed){
+    randomState = seed;
+}
+
+void Interpreter::setTimingModel(TimingModel model){
+    timingModel = model;
+    cycleOvershoot = 0;
+}
+
+TimingModel Interpreter::getTimingModel(){
+    return timingModel;
+}
+
+void Interpreter::setDisplayWait(bool enabled){
+    displayWait = enabled;
+    displayWaitCycle = 0;
+}
+
+void Interpreter::startDisplayWait(){
+    // Host driven timers end the wait on the next tickTimers
+    displayWaitCycle = UINT64_MAX;
+    if(cyclesPerTimerTick != 0){
+        displayWaitCycle = (cycleCount / cyclesPerTimerTick + 1) * cyclesPerTimerTick;
+    }
+    stopCycle = 0;
+}
+
+bool Interpreter::waitForDisplay(uint64_t endCycle){
+    if(cycleCount >= displayWaitCycle){
+        return true;
+    }
+    if(displayWaitCycle >= endCycle){
+        // The rest of the run is spent waiting
+        return false;
+    }
+    cycleCount = displayWaitCycle;
+    return true;
+}
+
+void Interpreter::setFusion(bool enabled){
+    fusion = enabled;
+}
+
+uint64_t Interpreter::getFusionCount(Fusion fusion){
+    return fusionCounts[(std::size_t) fusion];
+}
+
+uint64_t Interpreter::getFusedInstructionCount(Fusion fusion){
+    return fusedInstructions[(std::size_t) fusion];
+}
+
+void Interpreter::resetFusionCounts(){
+    for(std::size_t fusion = 0; fusion < (std::size_t) Fusion::COUNT; fusion++){
+        fusionCounts[fusion] = 0;
+        fusedInstructions[fusion] = 0;
+    }
+}
+
+void Interpreter::setNativeProgram(NativeProgram *program){
+    nativeProgram = program;
+}
+
+uint64_t Interpreter::getNativeInstructionCount(){
+    return nativeInstructions;
+}
+
+void Interpreter::addBreakpoint(uint16_t address, BreakpointCondition condition){
+    breakpoints[address] = std::move(condition);
+    memory.setTrap(address);
+}
+
+void Interpreter::removeBreakpoint(uint16_t address){
+    breakpoints.erase(address);
+    if(!stepping || stepAddress != address){
+        memory.clearTrap(address);
+    }
+}
+
+void Interpreter::clearBreakpoints(){
+    while(!breakpoints.empty()){
+        removeBreakpoint(breakpoints.begin()->first);
+    }
+}
+
+void Interpreter::stepOver(){
+    cancelStep();
+
+    // Calls are run until they return to the same stack depth
+    uint16_t opcode = (memory.read(registers.PC) << 8) | memory.read(registers.PC + 1);
+    if((opcode & 0xF000) == 0x2000){
+        armStep((registers.PC + 2) % 0x1000, registers.SP);
+    }else{
+        singleStep = true;
+    }
+}
+
+bool Interpreter::stepOut(){
+    // The stack starts at 0x200 and grows down
+    if(registers.SP >= 0x200){
+        return false;
+    }
+
+    cancelStep();
+    uint16_t address = (memory.read(registers.SP) << 8) | memory.read(registers.SP + 1);
+    armStep(address, registers.SP + 2);
+    return true;
+}
+
+void Interpreter::cancelStep(){
+    if(stepping){
+        stepping = false;
+        if(breakpoints.count(stepAddress) == 0){
+            memory.clearTrap(stepAddress);
+        }
+    }
+    singleStep = false;
+}
+
+void Interpreter::setStateHashing(bool enabled){
+    memory.setHashing(enabled);
+}
+
+uint64_t Interpreter::hash(){
+    uint64_t memoryHash = memory.isHashing()? memory.getHash(): memory.computeHash();
+    uint64_t stateHash = combineStateHash(memoryHash, screen.getHash());
+
+    if(hashValidation){
+        uint64_t computed = computeHash();
+        if(computed != stateHash){
+            hashMismatches++;
+        }
+        return computed;
     }
+    return stateHash;
+}
+
+uint64_t Interpreter::computeHash(){
+    return combineStateHash(memory.computeHash(), screen.computeHash());
+}
+
+void Interpreter::setHashValidation(bool enabled){
+    hashValidation = enabled;
+}
+
+uint64_t Interpreter::getHashMismatchCount(){
+    return hashMismatches;
+}
 
-    if(registers.ST > 0){
-        registers.ST--;
+uint64_t Interpreter::combineStateHash(uint64_t memoryHash, uint64_t screenHash){
+    uint64_t stateHash = 0;
+    for(std::size_t registerNumber = 0; registerNumber < 16; registerNumber++){
+        stateHash = combineHash(stateHash, registers.V[registerNumber]);
     }
+    stateHash = combineHash(stateHash, registers.I);
+    stateHash = combineHash(stateHash, registers.PC);
+    stateHash = combineHash(stateHash, registers.SP);
+    stateHash = combineHash(stateHash, getDelayTimer());
+    stateHash = combineHash(stateHash, getSoundTimer());
+
+    InputState inputState = input.getState();
+    stateHash = combineHash(stateHash, inputState.waiting? 0x100 | inputState.waitedRegister: 0);
+    stateHash = combineHash(stateHash, randomState);
+
+    // Cycles owed and left to wait decide how much the next run executes
+    uint64_t displayWaitCycles = 0;
+    if(displayWaitCycle > cycleCount){
+        displayWaitCycles = (displayWaitCycle == UINT64_MAX)? UINT64_MAX: displayWaitCycle - cycleCount;
+    }
+    stateHash = combineHash(stateHash, cycleOvershoot);
+    stateHash = combineHash(stateHash, displayWaitCycles);
+
+    stateHash = combineHash(stateHash, memoryHash);
+    return combineHash(stateHash, screenHash);
+}
+
+StopReason Interpreter::getStopReason(){
+    return stopReason;
+}
+
+WatchHit Interpreter::getWatchHit(){
+    return watchHit;
+}
 
+uint64_t Interpreter::getCycleCount(){
+    return cycleCount;
 }
 
 bool Interpreter::hasExecutionHalted(){
     return input.isWaiting();
 }
 
+void Interpreter::waitUntilRunnable(){
+    // The timers tick once every 1/60th of a second
+    const std::chrono::steady_clock::duration timerPeriod =
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1.0 / 60.0));
+
+    std::chrono::steady_clock::time_point nextTimerTick = std::chrono::steady_clock::now() + timerPeriod;
+    while(hasExecutionHalted()){
+        // With both timers stopped, nothing changes until a key arrives
+        if(getDelayTimer() == 0 && getSoundTimer() == 0){
+            input.waitForDelivery();
+            break;
+        }
+
+        // Sleep until the next timer tick, waking early for a key press
+        if(!input.waitForDelivery(nextTimerTick)){
+            // Cycle derived timers advance by the cycles spent asleep
+            cycleCount += cyclesPerTimerTick;
+            tickTimers();
+            nextTimerTick += timerPeriod;
+        }
+    }
+}
+
+bool Interpreter::waitUntilRunnable(std::chrono::steady_clock::time_point deadline){
+    return input.waitForDelivery(deadline);
+}
+
 void Interpreter::loadProgram(std::string programPath){
     // Load the file in binary mode
     std::ifstream programFile(programPath, std::ios_base::binary);
@@ -604,3 +1261,10 @@ void Interpreter::loadProgram(std::string programPath){
     // Close the file
     programFile.close();
 }
+
+void Interpreter::loadProgram(const uint8_t *program, std::size_t size){
+    // Programs are loaded at the program counter
+    for(std::size_t byte = 0; byte < size && registers.PC + byte < 0x1000; byte++){
+        memory[registers.PC + byte] = program[byte];
+    }
+}
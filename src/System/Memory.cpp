@@ -1,5 +1,317 @@
 #include <ChipM8/System/Memory.h>
+#include <ChipM8/System/StateHash.h>
+
+#include <cstring>
+
+static const uint8_t TRAPPED_PAGE = 0x80; // Page flag of pages holding traps
+
+/**
+ * Returns the image of all zeros shared by new Memory
+ **/
+static std::shared_ptr<const MemoryImage> getBlankImage(){
+    static const std::shared_ptr<const MemoryImage> blank = std::make_shared<const MemoryImage>();
+    return blank;
+}
+
+Memory::Memory(){
+    for(std::size_t page = 0; page < 0x100; page++){
+        pageFlags[page] = 0;
+        pageHashes[page] = 0;
+        staleHashPages[page] = false;
+    }
+    watchHit = {0, 0, Watch::Read, 0};
+    watchHitPending = false;
+    hashing = false;
+    hash = 0;
+    staleHash = false;
+    setImage(getBlankImage());
+}
 
 uint8_t &Memory::operator[](std::size_t index){
-    return data[index];
+    uint8_t page = (index >> 8) & 0xFF;
+    uint8_t *data = makePrivate(page, true);
+    writtenPages[page] = true;
+    if(hashing){
+        staleHashPages[page] = true;
+        staleHash = true;
+    }
+    return data[index & 0xFF];
+}
+
+void Memory::setImage(std::shared_ptr<const MemoryImage> image){
+    this->image = std::move(image);
+    for(std::size_t page = 0; page < 0x100; page++){
+        share(page);
+        writtenPages[page] = true;
+        if(hashing){
+            hashPage(page);
+        }
+    }
+}
+
+std::shared_ptr<const MemoryImage> Memory::createImage(){
+    std::shared_ptr<MemoryImage> created = std::make_shared<MemoryImage>();
+    for(std::size_t page = 0; page < 0x100; page++){
+        std::memcpy(created->data + (page << 8), readPages[page], 0x100);
+    }
+    return created;
+}
+
+std::size_t Memory::getPrivatePageCount(){
+    std::size_t count = 0;
+    for(std::size_t page = 0; page < 0x100; page++){
+        count += isPrivate(page);
+    }
+    return count;
+}
+
+bool Memory::isPageWritten(uint8_t page){
+    return writtenPages[page];
+}
+
+void Memory::clearWrittenPages(){
+    for(std::size_t page = 0; page < 0x100; page++){
+        writtenPages[page] = false;
+    }
+}
+
+void Memory::saveState(MemoryState &state){
+    state.image = image;
+    state.pages.clear();
+    for(std::size_t page = 0; page < 0x100; page++){
+        if(!isPrivate(page)){
+            state.slots[page] = -1;
+        }else{
+            state.slots[page] = (int16_t) (state.pages.size() >> 8);
+            state.pages.insert(state.pages.end(), readPages[page], readPages[page] + 0x100);
+        }
+    }
+}
+
+void Memory::restoreState(const MemoryState &state, bool writtenOnly){
+    // Pages not written since refer to a different image
+    if(state.image != image){
+        image = state.image;
+        writtenOnly = false;
+    }
+
+    for(std::size_t page = 0; page < 0x100; page++){
+        if(writtenOnly && !writtenPages[page]){
+            continue;
+        }
+
+        if(state.slots[page] < 0){
+            share(page);
+        }else{
+            std::memcpy(makePrivate(page, false), state.pages.data() + (state.slots[page] << 8), 0x100);
+            updateFetchPage(page);
+        }
+        if(hashing){
+            hashPage(page);
+        }
+    }
+}
+
+void Memory::addWatchpoint(uint16_t address, Watch access){
+    watchpoints[address] = access;
+    updatePageFlags(address >> 8);
+}
+
+void Memory::removeWatchpoint(uint16_t address){
+    watchpoints.erase(address);
+    updatePageFlags(address >> 8);
+}
+
+void Memory::clearWatchpoints(){
+    watchpoints.clear();
+    for(std::size_t page = 0; page < 0x100; page++){
+        updatePageFlags(page);
+    }
+}
+
+bool Memory::hasWatchpoints(){
+    return !watchpoints.empty();
+}
+
+WatchHit Memory::getWatchHit(){
+    return watchHit;
+}
+
+void Memory::clearWatchHit(){
+    watchHitPending = false;
+}
+
+void Memory::setHashing(bool enabled){
+    hashing = enabled;
+    for(std::size_t page = 0; page < 0x100; page++){
+        if(hashing){
+            hashPage(page);
+        }
+        updateWritePage(page);
+    }
+}
+
+bool Memory::isHashing(){
+    return hashing;
+}
+
+uint64_t Memory::getHash(){
+    if(staleHash){
+        for(std::size_t page = 0; page < 0x100; page++){
+            if(staleHashPages[page]){
+                hashPage(page);
+            }
+        }
+        staleHash = false;
+    }
+    return hash;
+}
+
+uint64_t Memory::computeHash(){
+    uint64_t computed = 0;
+    for(uint32_t address = 0; address < 0x10000; address++){
+        computed ^= hashMemoryByte(address, readPages[address >> 8][address & 0xFF]);
+    }
+    return computed;
+}
+
+void Memory::setTrap(uint16_t address){
+    traps.insert(address);
+    updatePageFlags(address >> 8);
+}
+
+void Memory::clearTrap(uint16_t address){
+    traps.erase(address);
+    updatePageFlags(address >> 8);
+}
+
+bool Memory::isTrap(uint16_t address){
+    return traps.count(address) != 0;
+}
+
+bool Memory::hasTraps(){
+    return !traps.empty();
+}
+
+void Memory::refreshTraps(){
+    for(std::size_t page = 0; page < 0x100; page++){
+        if(pageFlags[page] & TRAPPED_PAGE){
+            updateFetchPage(page);
+        }
+    }
+}
+
+uint8_t Memory::loadWatched(uint16_t address){
+    uint8_t value = readPages[address >> 8][address & 0xFF];
+
+    auto watchpoint = watchpoints.find(address);
+    if(!watchHitPending && watchpoint != watchpoints.end() && ((uint8_t) watchpoint->second & (uint8_t) Watch::Read)){
+        watchHit = {0, address, Watch::Read, value};
+        watchHitPending = true;
+    }
+    return value;
+}
+
+void Memory::writeSlow(uint16_t address, uint8_t value){
+    uint8_t page = address >> 8;
+    if(!watchHitPending && (pageFlags[page] & (uint8_t) Watch::Write)){
+        auto watchpoint = watchpoints.find(address);
+        if(watchpoint != watchpoints.end() && ((uint8_t) watchpoint->second & (uint8_t) Watch::Write)){
+            watchHit = {0, address, Watch::Write, value};
+            watchHitPending = true;
+        }
+    }
+
+    if(hashing){
+        uint64_t change = hashMemoryByte(address, readPages[page][address & 0xFF]) ^ hashMemoryByte(address, value);
+        pageHashes[page] ^= change;
+        hash ^= change;
+    }
+
+    makePrivate(address >> 8, true)[address & 0xFF] = value;
+    writtenPages[address >> 8] = true;
+    if(pageFlags[address >> 8] & TRAPPED_PAGE){
+        updateFetchPage(address >> 8);
+    }
+}
+
+void Memory::updatePageFlags(uint8_t page){
+    pageFlags[page] = 0;
+    for(std::size_t offset = 0; offset < 0x100; offset++){
+        uint16_t address = (page << 8) | offset;
+        auto watchpoint = watchpoints.find(address);
+        if(watchpoint != watchpoints.end()){
+            pageFlags[page] |= (uint8_t) watchpoint->second;
+        }
+        if(traps.count(address) != 0){
+            pageFlags[page] |= TRAPPED_PAGE;
+        }
+    }
+
+    updateWritePage(page);
+    updateFetchPage(page);
+}
+
+void Memory::updateWritePage(uint8_t page){
+    // Write watched and trapped pages, and all pages while hashing, divert writes to writeSlow
+    if(isPrivate(page)){
+        writePages[page] = divertsWrites(page)? nullptr: storage[page].get();
+    }
+}
+
+void Memory::hashPage(uint8_t page){
+    uint64_t pageHash = 0;
+    for(std::size_t offset = 0; offset < 0x100; offset++){
+        pageHash ^= hashMemoryByte((page << 8) | offset, readPages[page][offset]);
+    }
+    hash ^= pageHashes[page] ^ pageHash;
+    pageHashes[page] = pageHash;
+    staleHashPages[page] = false;
+}
+
+void Memory::updateFetchPage(uint8_t page){
+    if(!(pageFlags[page] & TRAPPED_PAGE)){
+        fetchPages[page] = readPages[page];
+        return;
+    }
+
+    if(!shadowPages[page]){
+        shadowPages[page].reset(new uint8_t[0x100]);
+    }
+    std::memcpy(shadowPages[page].get(), readPages[page], 0x100);
+    for(std::size_t offset = 0; offset < 0x100; offset++){
+        if(traps.count((page << 8) | offset) != 0){
+            shadowPages[page][offset] = TRAP_BYTE;
+        }
+    }
+    fetchPages[page] = shadowPages[page].get();
+}
+
+bool Memory::divertsWrites(uint8_t page){
+    return hashing || (pageFlags[page] & ((uint8_t) Watch::Write | TRAPPED_PAGE));
+}
+
+uint8_t *Memory::makePrivate(uint8_t page, bool copy){
+    if(!storage[page]){
+        storage[page].reset(new uint8_t[0x100]);
+    }
+    if(copy && !isPrivate(page)){
+        std::memcpy(storage[page].get(), readPages[page], 0x100);
+    }
+
+    readPages[page] = storage[page].get();
+    writePages[page] = divertsWrites(page)? nullptr: storage[page].get();
+    writtenPages[page] = true;
+    updateFetchPage(page);
+    return storage[page].get();
+}
+
+void Memory::share(uint8_t page){
+    readPages[page] = image->data + (page << 8);
+    writePages[page] = nullptr;
+    updateFetchPage(page);
+}
+
+bool Memory::isPrivate(uint8_t page){
+    return storage[page] && readPages[page] == storage[page].get();
 }
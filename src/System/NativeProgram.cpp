@@ -0,0 +1,73 @@
+#include <ChipM8/System/NativeProgram.h>
+
+#ifndef _WIN32
+#include <dlfcn.h>
+#endif
+
+NativeProgram::NativeProgram(){
+    handle = nullptr;
+    unload();
+}
+
+NativeProgram::~NativeProgram(){
+    unload();
+}
+
+bool NativeProgram::load(const std::string &path){
+    unload();
+
+#ifdef _WIN32
+    error = "Native programs are not supported on this platform";
+    return false;
+#else
+    handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if(handle == nullptr){
+        const char *reason = dlerror();
+        error = (reason != nullptr)? reason: "Could not open " + path;
+        return false;
+    }
+
+    const uint32_t *version = (const uint32_t *) dlsym(handle, "chipm8_native_version");
+    const uint32_t *count = (const uint32_t *) dlsym(handle, "chipm8_native_block_count");
+    const NativeBlock *table = (const NativeBlock *) dlsym(handle, "chipm8_native_blocks");
+    if(version == nullptr || count == nullptr || (table == nullptr && *count != 0)){
+        error = path + " is not a native program";
+        unload();
+        return false;
+    }
+    if(*version != NATIVE_VERSION){
+        error = path + " was compiled for a different native version";
+        unload();
+        return false;
+    }
+
+    for(uint32_t block = 0; block < *count; block++){
+        blocks[table[block].start & 0x0FFF] = &table[block];
+    }
+    blockCount = *count;
+    error.clear();
+    return true;
+#endif
+}
+
+std::string NativeProgram::getError(){
+    return error;
+}
+
+std::size_t NativeProgram::getBlockCount(){
+    return blockCount;
+}
+
+void NativeProgram::unload(){
+    for(std::size_t address = 0; address < 0x1000; address++){
+        blocks[address] = nullptr;
+    }
+    blockCount = 0;
+
+#ifndef _WIN32
+    if(handle != nullptr){
+        dlclose(handle);
+    }
+#endif
+    handle = nullptr;
+}
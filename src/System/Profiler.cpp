@@ -0,0 +1,118 @@
+#include <ChipM8/System/Profiler.h>
+#include <ChipM8/System/Instruction.h>
+
+#include <stdio.h>
+
+const std::size_t Profiler::MAX_DEPTH;
+
+Profiler::Profiler(){
+    reset();
+}
+
+void Profiler::enter(uint16_t address){
+    if(nodes[current].depth >= MAX_DEPTH){
+        return;
+    }
+
+    uint64_t key = ((uint64_t) current << 16) | address;
+    std::unordered_map<uint64_t, uint32_t>::iterator child = children.find(key);
+    if(child != children.end()){
+        current = child->second;
+        return;
+    }
+
+    CallNode node = {address, current, nodes[current].depth + 1, 0};
+    nodes.push_back(node);
+    children[key] = nodes.size() - 1;
+    current = nodes.size() - 1;
+}
+
+void Profiler::leave(){
+    // Returning from the outermost frame has nowhere to go
+    if(current != 0){
+        current = nodes[current].parent;
+    }
+}
+
+void Profiler::synchronize(Memory &memory, Registers &registers){
+    current = 0;
+
+    // The stack grows down from 0x200, outermost frame first
+    for(uint32_t address = 0x1FE; address >= registers.SP && address < 0x200; address -= 2){
+        uint16_t returnAddress = (memory.read(address) << 8) | memory.read(address + 1);
+
+        // The EXE before the return address names the subroutine
+        uint16_t callSite = (returnAddress - 2) & 0x0FFF;
+        uint16_t opcode = (memory.read(callSite) << 8) | memory.read(callSite + 1);
+        if((opcode & 0xF000) == 0x2000){
+            enter(opcode & 0x0FFF);
+        }else{
+            enter(callSite);
+        }
+    }
+}
+
+uint64_t Profiler::getAddressCycles(uint16_t address){
+    return addressCycles[address & 0x0FFF];
+}
+
+uint64_t Profiler::getTotalCycles(){
+    uint64_t total = 0;
+    for(std::size_t address = 0; address < 0x1000; address++){
+        total += addressCycles[address];
+    }
+    return total;
+}
+
+void Profiler::writeStack(std::ostream &out, uint32_t node){
+    if(node != 0){
+        writeStack(out, nodes[node].parent);
+        out << ";";
+    }
+
+    char address[8];
+    snprintf(address, sizeof(address), "0x%03X", nodes[node].address);
+    out << address;
+}
+
+void Profiler::writeCollapsedStacks(std::ostream &out){
+    for(uint32_t node = 0; node < nodes.size(); node++){
+        if(nodes[node].cycles == 0){
+            continue;
+        }
+        writeStack(out, node);
+        out << " " << nodes[node].cycles << "\n";
+    }
+}
+
+void Profiler::writeHeatTable(std::ostream &out){
+    uint64_t total = getTotalCycles();
+
+    out << "address,opcode,instruction,cycles,percent\n";
+    for(uint16_t address = 0; address < 0x1000; address++){
+        if(addressCycles[address] == 0){
+            continue;
+        }
+
+        char line[96];
+        snprintf(line, sizeof(line), "0x%03X,0x%04X,%s,%llu,%.3f\n",
+            address, opcodes[address], disassembleInstruction(opcodes[address]).c_str(),
+            (unsigned long long) addressCycles[address], 100.0 * addressCycles[address] / total);
+        out << line;
+    }
+}
+
+void Profiler::reset(){
+    nodes.clear();
+    children.clear();
+
+    // The root frame is the program entry point
+    CallNode root = {0x200, 0, 0, 0};
+    nodes.push_back(root);
+    current = 0;
+
+    for(std::size_t address = 0; address < 0x1000; address++){
+        addressCycles[address] = 0;
+        opcodes[address] = 0;
+    }
+}
@@ -0,0 +1,48 @@
+#include <ChipM8/System/Instruction.h>
+#include <ChipM8/System/Timing.h>
+
+#include <cstddef>
+
+uint32_t getVipCycles(uint16_t opcode, const Registers &registers){
+    // Fixed costs, fetch and dispatch included, in Instruction order
+    static const uint8_t cycles[] = {
+        23, 24, 23, 23, 23,     // OEXE CLS RET JUMP EXE
+        12, 12, 16,             // SEI SNEI SE
+        6, 10,                  // STRI ADDI
+        44, 44, 44, 44, 44,     // COPY OR AND XOR ADD
+        44, 44, 44, 44,         // SUB RSH SUBR LSH
+        16, 12, 23, 36,         // SNE STR BR RND
+        26,                     // DRAW
+        16, 16,                 // SP SNP
+        10, 10, 10, 10,         // STRD WAIT SETD SETS
+        19, 20,                 // OFFS NUM
+        40, 14, 14              // BCD STRM LDM
+    };
+    static_assert(sizeof(cycles) == (std::size_t) Instruction::COUNT);
+
+    Instruction instruction = decodeInstruction(opcode);
+    uint32_t cost = cycles[(std::size_t) instruction];
+
+    uint8_t registerX = (opcode & 0x0F00) >> 8;
+    uint8_t value = registers.V[registerX];
+    switch(instruction){
+        case Instruction::DRAW:{
+            // Unaligned rows are shifted a pixel at a time into two bytes
+            uint32_t rows = opcode & 0x000F;
+            uint32_t shift = value % 8;
+            cost += rows * ((shift == 0)? 18: 30 + 3 * shift);
+            break;
+        }
+        case Instruction::BCD:
+            // Each digit is found by repeated subtraction
+            cost += 12 * (value / 100 + (value / 10) % 10 + value % 10);
+            break;
+        case Instruction::STRM:
+        case Instruction::LDM:
+            cost += 14 * (registerX + 1);
+            break;
+        default:
+            break;
+    }
+    return cost;
+}
@@ -0,0 +1,182 @@
+#include <boost/test/unit_test.hpp>
+
+#include <ChipM8/System/Interpreter.h>
+
+/**
+ * A loop calling nested subroutines
+ *
+ * 0x200 6000   STRI V0, 0x00
+ * 0x202 7001   ADDI V0, 0x01
+ * 0x204 2210   EXE 0x210
+ * 0x206 6105   STRI V1, 0x05
+ * 0x208 1202   JUMP 0x202
+ * 0x210 7201   ADDI V2, 0x01
+ * 0x212 2218   EXE 0x218
+ * 0x214 7301   ADDI V3, 0x01
+ * 0x216 00EE   RET
+ * 0x218 7401   ADDI V4, 0x01
+ * 0x21A 00EE   RET
+ **/
+struct CallingProgram {
+    void setup(){
+        uint8_t program[] = {
+            0x60, 0x00, 0x70, 0x01, 0x22, 0x10, 0x61, 0x05, 0x12, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x72, 0x01, 0x22, 0x18, 0x73, 0x01, 0x00, 0xEE, 0x74, 0x01, 0x00, 0xEE
+        };
+        interpreter.loadProgram(program, sizeof(program));
+    }
+
+    Interpreter interpreter;
+};
+
+/**
+ * Breakpoint Tests
+ *
+ * Tests stopping run at breakpoints and stepping over
+ * and out of subroutines.
+ **/
+BOOST_AUTO_TEST_SUITE(BreakpointTests);
+
+/**
+ * run stops before the instruction at a breakpoint,
+ * and continues with it when run again.
+ **/
+BOOST_FIXTURE_TEST_CASE(BreakpointStopsRun, CallingProgram){
+    interpreter.addBreakpoint(0x206);
+
+    BOOST_TEST(interpreter.run(100) == 9);
+    BOOST_TEST((interpreter.getStopReason() == StopReason::Breakpoint));
+    BOOST_TEST(interpreter.registers.PC == 0x206);
+    BOOST_TEST(interpreter.getCycleCount() == 9);
+    BOOST_TEST(interpreter.registers.V[1] == 0);
+
+    BOOST_TEST(interpreter.run(100) == 10);
+    BOOST_TEST((interpreter.getStopReason() == StopReason::Breakpoint));
+    BOOST_TEST(interpreter.registers.PC == 0x206);
+    BOOST_TEST(interpreter.getCycleCount() == 19);
+    BOOST_TEST(interpreter.registers.V[0] == 2);
+    BOOST_TEST(interpreter.registers.V[1] == 5);
+}
+
+/**
+ * The instruction is still read as written, the trap
+ * is only seen by instruction fetches.
+ **/
+BOOST_FIXTURE_TEST_CASE(MemoryIsUnchanged, CallingProgram){
+    interpreter.addBreakpoint(0x206);
+    BOOST_TEST(interpreter.memory.read(0x206) == 0x61);
+    BOOST_TEST(interpreter.memory.fetch(0x206) == Memory::TRAP_BYTE);
+    BOOST_TEST(interpreter.memory.fetch(0x207) == 0x05);
+
+    interpreter.removeBreakpoint(0x206);
+    BOOST_TEST(interpreter.memory.fetch(0x206) == 0x61);
+    BOOST_TEST(interpreter.run(100) == 100);
+    BOOST_TEST((interpreter.getStopReason() == StopReason::None));
+}
+
+/**
+ * A conditional breakpoint only stops when its
+ * condition holds.
+ **/
+BOOST_FIXTURE_TEST_CASE(ConditionalBreakpoint, CallingProgram){
+    interpreter.addBreakpoint(0x202, [](const Registers &registers){
+        return registers.V[0] == 3;
+    });
+
+    interpreter.run(1000);
+    BOOST_TEST((interpreter.getStopReason() == StopReason::Breakpoint));
+    BOOST_TEST(interpreter.registers.PC == 0x202);
+    BOOST_TEST(interpreter.registers.V[0] == 3);
+    BOOST_TEST(interpreter.registers.V[4] == 3);
+}
+
+/**
+ * Breakpoints that do not stop leave the execution
+ * unchanged, with and without fusion.
+ **/
+BOOST_FIXTURE_TEST_CASE(PassingBreakpointsAreInvisible, CallingProgram){
+    Interpreter reference;
+    reference.memory.setImage(interpreter.memory.createImage());
+    reference.run(1000);
+
+    for(bool fusion : {true, false}){
+        Interpreter debugged;
+        debugged.memory.setImage(interpreter.memory.createImage());
+        debugged.setFusion(fusion);
+        debugged.addBreakpoint(0x210, [](const Registers &){ return false; });
+        debugged.addBreakpoint(0x21A, [](const Registers &){ return false; });
+
+        BOOST_TEST(debugged.run(1000) == 1000);
+        BOOST_TEST(debugged.registers.PC == reference.registers.PC);
+        BOOST_TEST(debugged.registers.SP == reference.registers.SP);
+        for(std::size_t registerNumber = 0; registerNumber < 16; registerNumber++){
+            BOOST_TEST(debugged.registers.V[registerNumber] == reference.registers.V[registerNumber]);
+        }
+    }
+}
+
+/**
+ * Stepping over a call runs the subroutine until it
+ * returns, other instructions are stepped one at a time.
+ **/
+BOOST_FIXTURE_TEST_CASE(StepOver, CallingProgram){
+    interpreter.addBreakpoint(0x204);
+    interpreter.run(100);
+    BOOST_TEST(interpreter.registers.PC == 0x204);
+
+    interpreter.stepOver();
+    BOOST_TEST(interpreter.run(100) == 7);
+    BOOST_TEST((interpreter.getStopReason() == StopReason::Step));
+    BOOST_TEST(interpreter.registers.PC == 0x206);
+    BOOST_TEST(interpreter.registers.V[3] == 1);
+    BOOST_TEST(interpreter.registers.V[4] == 1);
+
+    interpreter.stepOver();
+    BOOST_TEST(interpreter.run(100) == 1);
+    BOOST_TEST((interpreter.getStopReason() == StopReason::Step));
+    BOOST_TEST(interpreter.registers.PC == 0x208);
+    BOOST_TEST(interpreter.registers.V[1] == 5);
+
+    // The step is complete, run is no longer stopped
+    interpreter.removeBreakpoint(0x204);
+    BOOST_TEST(interpreter.run(100) == 100);
+}
+
+/**
+ * Stepping out runs until the current subroutine
+ * returns to its caller.
+ **/
+BOOST_FIXTURE_TEST_CASE(StepOut, CallingProgram){
+    BOOST_TEST(!interpreter.stepOut());
+
+    interpreter.addBreakpoint(0x218);
+    interpreter.run(100);
+    BOOST_TEST(interpreter.registers.PC == 0x218);
+    BOOST_TEST(interpreter.registers.SP == 0x1FC);
+
+    BOOST_TEST(interpreter.stepOut());
+    BOOST_TEST(interpreter.run(100) == 2);
+    BOOST_TEST((interpreter.getStopReason() == StopReason::Step));
+    BOOST_TEST(interpreter.registers.PC == 0x214);
+    BOOST_TEST(interpreter.registers.SP == 0x1FE);
+
+    BOOST_TEST(interpreter.stepOut());
+    BOOST_TEST(interpreter.run(100) == 2);
+    BOOST_TEST(interpreter.registers.PC == 0x206);
+    BOOST_TEST(interpreter.registers.SP == 0x200);
+}
+
+/**
+ * Host writes to a page holding breakpoints are
+ * fetched by the next run.
+ **/
+BOOST_FIXTURE_TEST_CASE(HostWritesAreFetched, CallingProgram){
+    interpreter.addBreakpoint(0x206);
+    interpreter.memory[0x207] = 0x07;
+
+    interpreter.run(100);
+    interpreter.run(2);
+    BOOST_TEST(interpreter.registers.V[1] == 7);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -0,0 +1,132 @@
+#include <boost/test/unit_test.hpp>
+
+#include <ChipM8/Analysis/ControlFlowGraph.h>
+
+#include <utility>
+#include <vector>
+
+/**
+ * Program with a skip, a call, a computed jump and data
+ *
+ * 0x200 6000   STRI V0, 0x00
+ * 0x202 3000   SEI  V0, 0x00
+ * 0x204 2210   EXE  0x210
+ * 0x206 B300   BR   0x300
+ * 0x208 ....   data
+ * 0x210 7001   ADDI V0, 0x01
+ * 0x212 00EE   RET
+ * 0x214 AABB   data
+ **/
+struct AnalysedProgram {
+    AnalysedProgram(): graph(program.data(), program.size()){
+    }
+
+    std::vector<uint8_t> program = {
+        0x60, 0x00, 0x30, 0x00, 0x22, 0x10, 0xB3, 0x00,
+        0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+        0x70, 0x01, 0x00, 0xEE, 0xAA, 0xBB
+    };
+    ControlFlowGraph graph;
+};
+
+/**
+ * Control Flow Graph Tests
+ *
+ * Tests the static analysis of programs
+ * into basic blocks.
+ **/
+BOOST_AUTO_TEST_SUITE(ControlFlowGraphTests);
+
+/**
+ * The reachable instructions are split into
+ * blocks at every control transfer and target.
+ **/
+BOOST_FIXTURE_TEST_CASE(SplitBlocks, AnalysedProgram){
+    const std::vector<BasicBlock> &blocks = graph.getBlocks();
+    BOOST_TEST(blocks.size() == 4);
+
+    BOOST_TEST(blocks[0].start == 0x200);
+    BOOST_TEST(blocks[0].end == 0x204);
+    BOOST_TEST(blocks[0].instructions == 2);
+    BOOST_TEST(blocks[0].successors.size() == 2);
+    BOOST_TEST(blocks[0].successors[0].target == 0x204);
+    BOOST_TEST(blocks[0].successors[1].target == 0x206);
+
+    BOOST_TEST(blocks[1].start == 0x204);
+    BOOST_TEST((blocks[1].successors[0].kind == EdgeKind::Call));
+    BOOST_TEST(blocks[1].successors[0].target == 0x210);
+    BOOST_TEST((blocks[1].successors[1].kind == EdgeKind::Return));
+    BOOST_TEST(blocks[1].successors[1].target == 0x206);
+
+    BOOST_TEST(blocks[2].start == 0x206);
+    BOOST_TEST(blocks[2].computedJump);
+    BOOST_TEST(blocks[2].successors.empty());
+
+    BOOST_TEST(blocks[3].start == 0x210);
+    BOOST_TEST(blocks[3].returns);
+}
+
+/**
+ * Instructions can be looked up by address.
+ **/
+BOOST_FIXTURE_TEST_CASE(FindBlocks, AnalysedProgram){
+    BOOST_TEST(graph.findBlock(0x202) == &graph.getBlocks()[0]);
+    BOOST_TEST(graph.findBlock(0x212) == &graph.getBlocks()[3]);
+    BOOST_TEST(graph.findBlock(0x208) == nullptr);
+    BOOST_TEST(graph.isCode(0x213));
+    BOOST_TEST(!graph.isCode(0x214));
+}
+
+/**
+ * Subroutines, computed jumps and data
+ * regions are reported.
+ **/
+BOOST_FIXTURE_TEST_CASE(ReportFindings, AnalysedProgram){
+    BOOST_TEST(graph.getSubroutines() == std::vector<uint16_t>({0x210}));
+    BOOST_TEST(graph.getComputedJumps() == std::vector<uint16_t>({0x206}));
+
+    std::vector<std::pair<uint16_t, uint16_t>> data = graph.getDataRegions();
+    BOOST_TEST(data.size() == 2);
+    BOOST_TEST(data[0].first == 0x208);
+    BOOST_TEST(data[0].second == 0x210);
+    BOOST_TEST(data[1].first == 0x214);
+    BOOST_TEST(data[1].second == 0x216);
+}
+
+/**
+ * Jumping into the middle of a run of
+ * instructions splits it into two blocks.
+ *
+ * 0x200 6000   STRI V0, 0x00
+ * 0x202 7001   ADDI V0, 0x01
+ * 0x204 1202   JUMP 0x202
+ **/
+BOOST_AUTO_TEST_CASE(SplitAtJumpTarget){
+    uint8_t program[] = {0x60, 0x00, 0x70, 0x01, 0x12, 0x02};
+    ControlFlowGraph graph(program, sizeof(program));
+
+    const std::vector<BasicBlock> &blocks = graph.getBlocks();
+    BOOST_TEST(blocks.size() == 2);
+    BOOST_TEST((blocks[0].successors[0].kind == EdgeKind::Fallthrough));
+    BOOST_TEST(blocks[0].successors[0].target == 0x202);
+    BOOST_TEST(blocks[1].start == 0x202);
+    BOOST_TEST(blocks[1].successors[0].target == 0x202);
+    BOOST_TEST(graph.getDataRegions().empty());
+}
+
+/**
+ * An origin outside of the 12-bit address
+ * space is wrapped like the entry point.
+ **/
+BOOST_AUTO_TEST_CASE(WrapOrigin){
+    uint8_t program[] = {0x60, 0x00, 0x70, 0x01, 0x12, 0x02};
+    ControlFlowGraph graph(program, sizeof(program), 0x1200);
+
+    const std::vector<BasicBlock> &blocks = graph.getBlocks();
+    BOOST_TEST(blocks.size() == 2);
+    BOOST_TEST(blocks[0].start == 0x200);
+    BOOST_TEST(blocks[1].start == 0x202);
+    BOOST_TEST(graph.isInstruction(0x204));
+}
+
+BOOST_AUTO_TEST_SUITE_END();
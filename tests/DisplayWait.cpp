@@ -0,0 +1,116 @@
+#include <boost/test/unit_test.hpp>
+
+#include <ChipM8/System/Interpreter.h>
+
+/**
+ * A loop counting its draws
+ *
+ * 0x200 7001   ADDI V0, 0x01
+ * 0x202 D111   DRAW V1, V1, 1
+ * 0x204 1200   JUMP 0x200
+ **/
+struct DrawingProgram {
+    void setup(){
+        uint8_t program[] = {0x70, 0x01, 0xD1, 0x11, 0x12, 0x00};
+        interpreter.loadProgram(program, sizeof(program));
+        interpreter.setDisplayWait(true);
+    }
+
+    Interpreter interpreter;
+};
+
+/**
+ * Display Wait Tests
+ *
+ * Tests DRAW waiting for the next frame.
+ **/
+BOOST_AUTO_TEST_SUITE(DisplayWaitTests);
+
+/**
+ * With host driven timers a DRAW waits until
+ * the next tickTimers.
+ **/
+BOOST_FIXTURE_TEST_CASE(WaitsForTimerTick, DrawingProgram){
+    BOOST_TEST(interpreter.run(1000) == 2);
+    BOOST_TEST(interpreter.getCycleCount() == 1000);
+
+    // Still the same frame
+    BOOST_TEST(interpreter.run(1000) == 0);
+    interpreter.tick();
+    BOOST_TEST(interpreter.registers.PC == 0x204);
+
+    for(int frame = 0; frame < 5; frame++){
+        interpreter.tickTimers();
+        BOOST_TEST(interpreter.run(1000) == 3);
+    }
+    BOOST_TEST(interpreter.registers.V[0] == 6);
+}
+
+/**
+ * With cycle derived timers a run continues at
+ * the next timer tick.
+ **/
+BOOST_FIXTURE_TEST_CASE(ContinuesAtNextTimerTick, DrawingProgram){
+    interpreter.setCyclesPerTimerTick(100);
+
+    interpreter.run(1000);
+    BOOST_TEST(interpreter.registers.V[0] == 10);
+    BOOST_TEST(interpreter.getCycleCount() == 1000);
+
+    // A run ending mid frame resumes the wait in the next run
+    interpreter.run(150);
+    BOOST_TEST(interpreter.registers.V[0] == 12);
+    interpreter.run(49);
+    BOOST_TEST(interpreter.registers.V[0] == 12);
+    // JUMP at the tick, then ADDI
+    interpreter.run(3);
+    BOOST_TEST(interpreter.registers.V[0] == 13);
+}
+
+/**
+ * Fused draws wait too, and disabling the wait
+ * runs every cycle again. Instrumented builds
+ * never fuse, so they only check the wait.
+ **/
+BOOST_AUTO_TEST_CASE(FusedDrawsWait){
+    // 0x200 6000 STRI V0, 0x00; 0x202 6100 STRI V1, 0x00; 0x204 D011 DRAW V0, V1, 1
+    // 0x206 7201 ADDI V2, 0x01; 0x208 1200 JUMP 0x200
+    uint8_t program[] = {0x60, 0x00, 0x61, 0x00, 0xD0, 0x11, 0x72, 0x01, 0x12, 0x00};
+    Interpreter interpreter;
+    interpreter.loadProgram(program, sizeof(program));
+    interpreter.setDisplayWait(true);
+    interpreter.setFusion(true);
+
+    interpreter.run(1000);
+#ifndef CHIPM8_INSTRUMENTATION
+    BOOST_TEST(interpreter.getFusionCount(Fusion::PositionDraw) == 1);
+#endif
+    BOOST_TEST(interpreter.registers.V[2] == 0);
+
+    interpreter.tickTimers();
+    interpreter.run(1000);
+    BOOST_TEST(interpreter.registers.V[2] == 1);
+
+    interpreter.setDisplayWait(false);
+    interpreter.run(1000);
+    BOOST_TEST(interpreter.registers.V[2] == 201);
+}
+
+/**
+ * A pending wait is restored with a snapshot.
+ **/
+BOOST_FIXTURE_TEST_CASE(WaitIsSnapshotted, DrawingProgram){
+    Snapshot snapshot;
+    interpreter.run(10);
+    interpreter.saveSnapshot(snapshot);
+
+    interpreter.tickTimers();
+    interpreter.run(10);
+    BOOST_TEST(interpreter.registers.V[0] == 2);
+
+    interpreter.restoreSnapshot(snapshot);
+    BOOST_TEST(interpreter.run(10) == 0);
+    BOOST_TEST(interpreter.registers.V[0] == 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -0,0 +1,103 @@
+#include <boost/test/unit_test.hpp>
+
+#include <ChipM8/System/Interpreter.h>
+
+#include <chrono>
+#include <thread>
+
+/**
+ * Loads a small program which waits for a key press
+ * into V5 and then copies it into V6.
+ *
+ * 0x200 F50A   WAIT V5
+ * 0x202 8650   COPY V6, V5
+ * 0x204 1204   JUMP 0x204
+ **/
+struct WaitingProgram {
+    void setup(){
+        uint8_t program[] = {0xF5, 0x0A, 0x86, 0x50, 0x12, 0x04};
+        for(std::size_t byte = 0; byte < sizeof(program); byte++){
+            interpreter.memory[0x200 + byte] = program[byte];
+        }
+    }
+
+    Interpreter interpreter;
+};
+
+/**
+ * Execution Halting Tests
+ *
+ * Tests the behaviour of the Interpreter
+ * while a WAIT (FX0A) instruction is pending.
+ **/
+BOOST_AUTO_TEST_SUITE(ExecutionHaltingTests);
+
+/**
+ * Ticking a halted Interpreter should not
+ * execute any instructions.
+ **/
+BOOST_FIXTURE_TEST_CASE(TickWhileHalted, WaitingProgram){
+    interpreter.tick();
+    BOOST_TEST(interpreter.hasExecutionHalted());
+
+    // Further ticks do nothing
+    interpreter.tick();
+    interpreter.tick();
+    BOOST_TEST(interpreter.registers.PC == 0x202);
+
+    // Deliver the key and resume
+    interpreter.input.setKeyPressed(0x9, true);
+    BOOST_TEST(!interpreter.hasExecutionHalted());
+    interpreter.tick();
+    BOOST_TEST(interpreter.registers.V[6] == 0x9);
+}
+
+/**
+ * Running should stop as soon as the
+ * Interpreter halts.
+ **/
+BOOST_FIXTURE_TEST_CASE(RunStopsWhenHalted, WaitingProgram){
+    BOOST_TEST(interpreter.run(100) == 1);
+    BOOST_TEST(interpreter.hasExecutionHalted());
+    BOOST_TEST(interpreter.run(100) == 0);
+
+    interpreter.input.setKeyPressed(0x3, true);
+    BOOST_TEST(interpreter.run(100) == 100);
+    BOOST_TEST(interpreter.registers.V[6] == 0x3);
+}
+
+/**
+ * Waiting with a deadline should time out
+ * if no key is pressed.
+ **/
+BOOST_FIXTURE_TEST_CASE(WaitUntilRunnableTimesOut, WaitingProgram){
+    interpreter.tick();
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(5);
+    BOOST_TEST(!interpreter.waitUntilRunnable(deadline));
+    BOOST_TEST(interpreter.hasExecutionHalted());
+}
+
+/**
+ * A key pressed on another thread should wake
+ * the Interpreter, with the timers having been
+ * ticked while it slept.
+ **/
+BOOST_FIXTURE_TEST_CASE(WaitUntilRunnableWakesOnKey, WaitingProgram){
+    interpreter.setDelayTimer(0xFF);
+    interpreter.tick();
+
+    std::thread presser([this]{
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        interpreter.input.setKeyPressed(0xA, true);
+    });
+
+    interpreter.waitUntilRunnable();
+    presser.join();
+
+    BOOST_TEST(!interpreter.hasExecutionHalted());
+    BOOST_TEST(interpreter.registers.V[5] == 0xA);
+    BOOST_TEST(interpreter.getDelayTimer() < 0xFF);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
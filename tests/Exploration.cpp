@@ -0,0 +1,128 @@
+#include <boost/test/unit_test.hpp>
+
+#include <ChipM8/Async/Explorer.h>
+
+#include <vector>
+
+/**
+ * A program counting the frames key 5 is held
+ *
+ * 0x200 6005   STRI V0, 0x05
+ * 0x202 E09E   SP V0
+ * 0x204 1208   JUMP 0x208
+ * 0x206 7101   ADDI V1, 0x01
+ * 0x208 7201   ADDI V2, 0x01
+ * 0x20A 1202   JUMP 0x202
+ **/
+struct ExploredProgram {
+    void setup(){
+        uint8_t program[] = {0x60, 0x05, 0xE0, 0x9E, 0x12, 0x08, 0x71, 0x01, 0x72, 0x01, 0x12, 0x02};
+        interpreter.loadProgram(program, sizeof(program));
+        interpreter.saveSnapshot(base);
+    }
+
+    /**
+     * Runs a schedule on a single Interpreter, the way
+     * the Explorer runs a branch
+     **/
+    void runSequentially(const InputSchedule &schedule, uint32_t frames){
+        interpreter.restoreSnapshot(base);
+        std::size_t event = 0;
+        for(uint32_t frame = 0; frame < frames; frame++){
+            for(; event < schedule.size() && schedule[event].frame <= frame; event++){
+                interpreter.input.setKeyPressed(schedule[event].key, schedule[event].pressed);
+            }
+            interpreter.run(CYCLES_PER_FRAME);
+            interpreter.tickTimers();
+        }
+    }
+
+    static const uint32_t CYCLES_PER_FRAME = 30;
+
+    Interpreter interpreter;
+    Snapshot base;
+};
+
+/**
+ * Exploration Tests
+ *
+ * Tests running branches of input schedules in parallel
+ * from a snapshot.
+ **/
+BOOST_AUTO_TEST_SUITE(ExplorationTests);
+
+/**
+ * Every branch ends in the state running its schedule
+ * on its own would.
+ **/
+BOOST_FIXTURE_TEST_CASE(BranchesMatchSequentialRuns, ExploredProgram){
+    std::vector<InputSchedule> schedules;
+    for(uint32_t hold = 0; hold < 12; hold++){
+        schedules.push_back({{hold % 4, 0x5, true}, {hold % 4 + hold / 4 + 1, 0x5, false}});
+    }
+
+    Explorer explorer(CYCLES_PER_FRAME, 3);
+    explorer.setDuplicateCutoff(false);
+    std::vector<BranchResult> results = explorer.explore(base, schedules, 10);
+
+    BOOST_TEST(results.size() == schedules.size());
+    for(std::size_t branch = 0; branch < schedules.size(); branch++){
+        runSequentially(schedules[branch], 10);
+        BOOST_TEST(!results[branch].duplicate);
+        BOOST_TEST(results[branch].frames == 10);
+        BOOST_TEST(results[branch].hash == interpreter.hash());
+        BOOST_TEST(results[branch].registers.V[1] == interpreter.registers.V[1]);
+        BOOST_TEST(results[branch].registers.PC == interpreter.registers.PC);
+    }
+    BOOST_TEST(results[0].registers.V[1] != results[11].registers.V[1]);
+}
+
+/**
+ * Branches reaching the same state with the same input
+ * to come are cut off, ending in the first one's state.
+ **/
+BOOST_FIXTURE_TEST_CASE(DuplicatesAreCutOff, ExploredProgram){
+    // The program ignores key 6, so these only differ in the first frame
+    std::vector<InputSchedule> schedules = {
+        {{0, 0x6, true}, {1, 0x6, false}, {3, 0x5, true}},
+        {{0, 0x7, true}, {1, 0x7, false}, {3, 0x5, true}},
+        {{0, 0x6, true}, {1, 0x6, false}, {4, 0x5, true}}
+    };
+
+    Explorer explorer(CYCLES_PER_FRAME, 2);
+    std::vector<BranchResult> results = explorer.explore(base, schedules, 10);
+
+    BOOST_TEST(results[0].duplicate != results[1].duplicate);
+    BranchResult &duplicate = results[0].duplicate? results[0]: results[1];
+    BOOST_TEST(duplicate.frames == 2);
+    BOOST_TEST(results[0].hash == results[1].hash);
+    BOOST_TEST(results[0].registers.V[1] == results[1].registers.V[1]);
+
+    // The same state with different input to come is not a duplicate
+    BOOST_TEST(!results[2].duplicate);
+    BOOST_TEST(results[2].hash != results[0].hash);
+}
+
+/**
+ * The pool is reused across explorations from
+ * different snapshots.
+ **/
+BOOST_FIXTURE_TEST_CASE(ExploresRepeatedly, ExploredProgram){
+    Explorer explorer(CYCLES_PER_FRAME, 2);
+    std::vector<InputSchedule> schedules = {{}, {{0, 0x5, true}}};
+
+    std::vector<BranchResult> first = explorer.explore(base, schedules, 5);
+
+    Snapshot later;
+    interpreter.restoreSnapshot(base);
+    interpreter.run(100);
+    interpreter.saveSnapshot(later);
+    std::vector<BranchResult> second = explorer.explore(later, schedules, 5);
+
+    // Without key 5 each iteration is 4 instructions
+    BOOST_TEST(second[0].registers.V[2] == first[0].registers.V[2] + 100 / 4);
+    BOOST_TEST(second[1].registers.V[1] > 0);
+    BOOST_TEST(explorer.getThreadCount() == 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -0,0 +1,89 @@
+#include <boost/test/unit_test.hpp>
+
+#include <ChipM8/System/FramePacer.h>
+
+#include <chrono>
+#include <thread>
+
+/**
+ * Interpreter running an endless loop
+ *
+ * 0x200 7001   ADDI V0, 0x01
+ * 0x202 1200   JUMP 0x200
+ **/
+struct PacedProgram {
+    void setup(){
+        uint8_t program[] = {0x70, 0x01, 0x12, 0x00};
+        interpreter.loadProgram(program, sizeof(program));
+    }
+
+    Interpreter interpreter;
+};
+
+/**
+ * Frame Pacing Tests
+ *
+ * Tests driving the Interpreter in real time.
+ **/
+BOOST_AUTO_TEST_SUITE(FramePacingTests);
+
+/**
+ * Frames are paced at the frame rate and run
+ * the instruction rate without losing the
+ * remainder of uneven divisions.
+ **/
+BOOST_FIXTURE_TEST_CASE(PacedFrames, PacedProgram){
+    FramePacer pacer(interpreter, 1000, 300);
+
+    auto start = std::chrono::steady_clock::now();
+    for(int frame = 0; frame < 30; frame++){
+        pacer.runFrame();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    // The first deadline is immediate
+    BOOST_TEST(elapsed >= std::chrono::milliseconds(96));
+    BOOST_TEST(interpreter.getCycleCount() == 100);
+
+    PacingStatistics statistics = pacer.getStatistics();
+    BOOST_TEST(statistics.wakeups == 30);
+    BOOST_TEST(statistics.maxJitter >= 0);
+}
+
+/**
+ * Late frames are emulated back to back when
+ * catching up.
+ **/
+BOOST_FIXTURE_TEST_CASE(CatchUpLateFrames, PacedProgram){
+    FramePacer pacer(interpreter, 6000, 1000);
+    pacer.setPolicy(FramePacer::Policy::CatchUp, 100);
+    pacer.runFrame();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    std::size_t frames = pacer.runFrame();
+
+    PacingStatistics statistics = pacer.getStatistics();
+    BOOST_TEST(frames >= 5);
+    BOOST_TEST(statistics.caughtUpFrames == frames - 1);
+    BOOST_TEST(statistics.droppedFrames == 0);
+    BOOST_TEST(interpreter.getCycleCount() == statistics.frames * 6);
+}
+
+/**
+ * Late frames are skipped when dropping.
+ **/
+BOOST_FIXTURE_TEST_CASE(DropLateFrames, PacedProgram){
+    FramePacer pacer(interpreter, 6000, 1000);
+    pacer.setPolicy(FramePacer::Policy::Drop);
+    pacer.runFrame();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    BOOST_TEST(pacer.runFrame() == 1);
+
+    PacingStatistics statistics = pacer.getStatistics();
+    BOOST_TEST(statistics.frames == 2);
+    BOOST_TEST(statistics.droppedFrames >= 4);
+    BOOST_TEST(interpreter.getCycleCount() == 12);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -0,0 +1,212 @@
+#include <boost/test/unit_test.hpp>
+
+#include <ChipM8/System/Interpreter.h>
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+/**
+ * Runs a program on two Interpreters, with and
+ * without fusion, in slices of the given cycles
+ *
+ * Instrumented builds never fuse, so the fusion
+ * counts are only checked without instrumentation.
+ **/
+struct FusionComparison {
+    void load(const std::vector<uint8_t> &program, uint32_t cyclesPerTimerTick = 0){
+        // The same seed makes RND agree
+        std::shared_ptr<const MemoryImage> image = Interpreter::createImage(program.data(), program.size());
+        fused.reset(image, 1);
+        unfused.reset(image, 1);
+        fused.setCyclesPerTimerTick(cyclesPerTimerTick);
+        unfused.setCyclesPerTimerTick(cyclesPerTimerTick);
+        fused.setFusion(true);
+    }
+
+    void run(std::size_t cycles){
+        std::size_t fusedExecuted = fused.run(cycles);
+        std::size_t unfusedExecuted = unfused.run(cycles);
+        BOOST_TEST(fusedExecuted == unfusedExecuted);
+    }
+
+    void tickTimers(){
+        fused.tickTimers();
+        unfused.tickTimers();
+    }
+
+    /**
+     * Checks that both Interpreters are in the same state
+     **/
+    bool isIdentical(){
+        bool identical = std::memcmp(fused.registers.V, unfused.registers.V, 16) == 0 &&
+            fused.registers.I == unfused.registers.I &&
+            fused.registers.PC == unfused.registers.PC &&
+            fused.registers.SP == unfused.registers.SP &&
+            fused.getCycleCount() == unfused.getCycleCount() &&
+            fused.getDelayTimer() == unfused.getDelayTimer() &&
+            fused.getSoundTimer() == unfused.getSoundTimer() &&
+            std::memcmp(fused.memory.createImage()->data, unfused.memory.createImage()->data, 0x10000) == 0;
+
+        for(uint8_t row = 0; row < 32; row++){
+            for(uint8_t col = 0; col < 64; col++){
+                identical = identical && fused.screen.getPixel(row, col) == unfused.screen.getPixel(row, col);
+            }
+        }
+        return identical;
+    }
+
+    Interpreter fused;
+    Interpreter unfused;
+};
+
+/**
+ * Fusion Tests
+ *
+ * Tests that superinstructions have exactly the
+ * effect of the sequences they replace.
+ **/
+BOOST_AUTO_TEST_SUITE(FusionTests);
+
+/**
+ * Positioning and drawing a sprite
+ *
+ * 0x200 6A08   STRI VA, 0x08
+ * 0x202 6B04   STRI VB, 0x04
+ * 0x204 DAB5   DRAW VA, VB, 0x5
+ * 0x206 1200   JUMP 0x200
+ **/
+BOOST_FIXTURE_TEST_CASE(PositionDraw, FusionComparison){
+    load({0x6A, 0x08, 0x6B, 0x04, 0xDA, 0xB5, 0x12, 0x00});
+    for(std::size_t cycles = 1; cycles <= 8; cycles++){
+        run(cycles);
+        BOOST_TEST(isIdentical());
+    }
+#ifndef CHIPM8_INSTRUMENTATION
+    BOOST_TEST(fused.getFusionCount(Fusion::PositionDraw) > 0);
+#endif
+    BOOST_TEST(fused.screen.getPixel(4, 8));
+}
+
+/**
+ * Pointing I into a table
+ *
+ * 0x200 6A07   STRI VA, 0x07
+ * 0x202 AFFE   STR 0xFFE
+ * 0x204 FA1E   OFFS VA
+ * 0x206 1200   JUMP 0x200
+ **/
+BOOST_FIXTURE_TEST_CASE(IndexOffset, FusionComparison){
+    load({0x6A, 0x07, 0xAF, 0xFE, 0xFA, 0x1E, 0x12, 0x00});
+    run(3);
+    BOOST_TEST(fused.registers.I == 0x005);
+#ifndef CHIPM8_INSTRUMENTATION
+    BOOST_TEST(fused.getFusionCount(Fusion::IndexOffset) == 1);
+#endif
+    BOOST_TEST(isIdentical());
+}
+
+/**
+ * Polling the delay timer, with host driven
+ * and cycle derived timers
+ *
+ * 0x200 6A05   STRI VA, 0x05
+ * 0x202 FA15   SETD VA
+ * 0x204 FB07   STRD VB
+ * 0x206 3B00   SEI VB, 0x00
+ * 0x208 1204   JUMP 0x204
+ * 0x20A 7C01   ADDI VC, 0x01
+ * 0x20C 1200   JUMP 0x200
+ **/
+BOOST_AUTO_TEST_CASE(TimerPoll){
+    std::vector<uint8_t> program = {0x6A, 0x05, 0xFA, 0x15, 0xFB, 0x07, 0x3B, 0x00, 0x12, 0x04, 0x7C, 0x01, 0x12, 0x00};
+
+    FusionComparison host;
+    host.load(program);
+    for(int frame = 0; frame < 20; frame++){
+        host.run(97);
+        host.tickTimers();
+        BOOST_TEST(host.isIdentical());
+    }
+    BOOST_TEST(host.fused.registers.V[0xC] > 0);
+#ifndef CHIPM8_INSTRUMENTATION
+    BOOST_TEST(host.fused.getFusionCount(Fusion::TimerPoll) > 0);
+#endif
+
+    FusionComparison derived;
+    derived.load(program, 100);
+    for(std::size_t cycles = 1; cycles < 700; cycles += 37){
+        derived.run(cycles);
+        BOOST_TEST(derived.isIdentical());
+    }
+    BOOST_TEST(derived.fused.registers.V[0xC] > 0);
+#ifndef CHIPM8_INSTRUMENTATION
+    BOOST_TEST(derived.fused.getFusionCount(Fusion::TimerPoll) > 0);
+#endif
+}
+
+/**
+ * Counting up to a limit
+ *
+ * 0x200 6AF0   STRI VA, 0xF0
+ * 0x202 7A01   ADDI VA, 0x01
+ * 0x204 3A10   SEI VA, 0x10
+ * 0x206 1202   JUMP 0x202
+ * 0x208 7B01   ADDI VB, 0x01
+ * 0x20A 1200   JUMP 0x200
+ **/
+BOOST_FIXTURE_TEST_CASE(CountedLoop, FusionComparison){
+    load({0x6A, 0xF0, 0x7A, 0x01, 0x3A, 0x10, 0x12, 0x02, 0x7B, 0x01, 0x12, 0x00});
+    for(std::size_t cycles = 1; cycles < 200; cycles += 7){
+        run(cycles);
+        BOOST_TEST(isIdentical());
+    }
+    BOOST_TEST(fused.registers.V[0xB] > 0);
+#ifndef CHIPM8_INSTRUMENTATION
+    BOOST_TEST(fused.getFusionCount(Fusion::CountedLoop) > 0);
+    BOOST_TEST(fused.getFusedInstructionCount(Fusion::CountedLoop) % 3 == 0);
+#endif
+}
+
+/**
+ * Random programs made of the fused sequences and
+ * random opcodes behave identically.
+ **/
+BOOST_AUTO_TEST_CASE(RandomPrograms){
+    std::mt19937 generator(1);
+
+    for(int programNumber = 0; programNumber < 50; programNumber++){
+        std::vector<uint8_t> program;
+        while(program.size() < 64){
+            uint16_t address = 0x200 + program.size();
+            uint8_t x = generator() % 16;
+            uint8_t y = generator() % 16;
+            std::vector<uint16_t> opcodes;
+            switch(generator() % 5){
+                case 0: opcodes = {(uint16_t) (0x6000 | x << 8 | (generator() & 0xFF)), (uint16_t) (0x6000 | y << 8 | (generator() & 0xFF)), (uint16_t) (0xD000 | x << 8 | y << 4 | (generator() & 0xF))}; break;
+                case 1: opcodes = {(uint16_t) (0xA000 | (generator() & 0xFFF)), (uint16_t) (0xF01E | x << 8)}; break;
+                case 2: opcodes = {(uint16_t) (0xF015 | x << 8), (uint16_t) (0xF007 | y << 8), (uint16_t) (0x3000 | y << 8), (uint16_t) (0x1000 | (address + 2))}; break;
+                case 3: opcodes = {(uint16_t) (0x7001 | x << 8), (uint16_t) (0x3000 | x << 8 | (generator() & 0xFF)), (uint16_t) (0x1000 | address)}; break;
+                default: opcodes = {(uint16_t) (generator() & 0xFFFF)}; break;
+            }
+            for(uint16_t opcode : opcodes){
+                program.push_back(opcode >> 8);
+                program.push_back(opcode & 0xFF);
+            }
+        }
+
+        FusionComparison comparison;
+        comparison.load(program, (programNumber % 2 == 0)? 0: 50);
+        for(int frame = 0; frame < 10; frame++){
+            comparison.run(1 + generator() % 200);
+            comparison.tickTimers();
+            BOOST_TEST(comparison.isIdentical());
+            if(comparison.fused.hasExecutionHalted()){
+                comparison.fused.input.setKeyPressed(0x1, true);
+                comparison.unfused.input.setKeyPressed(0x1, true);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END();
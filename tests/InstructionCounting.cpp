@@ -0,0 +1,75 @@
+#include <boost/test/unit_test.hpp>
+
+#include <boost/test/data/test_case.hpp>
+#include <boost/test/data/monomorphic.hpp>
+
+#include <ChipM8/System/Instruction.h>
+#include <ChipM8/System/Interpreter.h>
+
+#include <sstream>
+#include <string>
+
+// Alias namespace to bdata
+namespace bdata = boost::unit_test::data;
+
+/**
+ * Instruction Counting Tests
+ *
+ * Tests the decoding of opcodes into instructions
+ * and, when compiled in, the instruction counters.
+ **/
+BOOST_AUTO_TEST_SUITE(InstructionCountingTests);
+
+static auto DECODE_Opcode = bdata::make({0x0123, 0x00E0, 0x00EE, 0x1ABC, 0x8AB4, 0x8ABE, 0x8AB9, 0xD125, 0xE19E, 0xE1A1, 0xF10A, 0xF165, 0xF1FF});
+static auto DECODE_Name =   bdata::make({"OEXE", "CLS", "RET", "JUMP", "ADD", "LSH", "LSH", "DRAW", "SP", "SNP", "WAIT", "LDM", "LDM"});
+
+// Decode Data
+static auto DECODE_DATA = DECODE_Opcode ^ DECODE_Name;
+
+/**
+ * Opcodes decode to the instruction the
+ * Interpreter executes for them.
+ **/
+BOOST_DATA_TEST_CASE(DecodeTests, DECODE_DATA, opcode, name){
+    BOOST_TEST(std::string(getInstructionName(decodeInstruction(opcode))) == name);
+}
+
+#ifdef CHIPM8_INSTRUMENTATION
+
+/**
+ * Executes a short program and checks the
+ * counts of each instruction, the sprite
+ * heights and the skips.
+ *
+ * 0x200 6A01   STRI VA, 0x01
+ * 0x202 3A01   SEI  VA, 0x01 (taken)
+ * 0x204 0000   (skipped)
+ * 0x206 3A02   SEI  VA, 0x02 (not taken)
+ * 0x208 D005   DRAW V0, V0, 5
+ **/
+BOOST_AUTO_TEST_CASE(CountInstructions){
+    Interpreter interpreter;
+    uint8_t program[] = {0x6A, 0x01, 0x3A, 0x01, 0x00, 0x00, 0x3A, 0x02, 0xD0, 0x05};
+    for(std::size_t byte = 0; byte < sizeof(program); byte++){
+        interpreter.memory[0x200 + byte] = program[byte];
+    }
+
+    interpreter.run(4);
+
+    InstructionCounters &counters = interpreter.counters;
+    BOOST_TEST(counters.getTotal() == 4);
+    BOOST_TEST(counters.getCount(Instruction::STRI) == 1);
+    BOOST_TEST(counters.getCount(Instruction::SEI) == 2);
+    BOOST_TEST(counters.getCount(Instruction::DRAW) == 1);
+    BOOST_TEST(counters.getSpriteHeightCount(5) == 1);
+    BOOST_TEST(counters.getSkipCount(Instruction::SEI, true) == 1);
+    BOOST_TEST(counters.getSkipCount(Instruction::SEI, false) == 1);
+
+    std::ostringstream json;
+    counters.writeJSON(json);
+    BOOST_TEST(json.str().find("\"SEI\": {\"taken\": 1, \"notTaken\": 1}") != std::string::npos);
+}
+
+#endif
+
+BOOST_AUTO_TEST_SUITE_END();
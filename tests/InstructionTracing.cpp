@@ -0,0 +1,106 @@
+#include <boost/test/unit_test.hpp>
+
+#include <ChipM8/System/Interpreter.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * Interpreter tracing a short loop
+ *
+ * 0x200 6A01   STRI VA, 0x01
+ * 0x202 7A01   ADDI VA, 0x01
+ * 0x204 A123   STR  0x123
+ * 0x206 1202   JUMP 0x202
+ **/
+struct TracedProgram {
+    TracedProgram(): trace(8){
+        uint8_t program[] = {0x6A, 0x01, 0x7A, 0x01, 0xA1, 0x23, 0x12, 0x02};
+        for(std::size_t byte = 0; byte < sizeof(program); byte++){
+            interpreter.memory[0x200 + byte] = program[byte];
+        }
+        interpreter.setTrace(&trace);
+    }
+
+    InstructionTrace trace;
+    Interpreter interpreter;
+};
+
+/**
+ * Instruction Tracing Tests
+ *
+ * Tests recording executed instructions into
+ * a trace and flushing it to disk.
+ **/
+BOOST_AUTO_TEST_SUITE(InstructionTracingTests);
+
+/**
+ * Records hold the instruction and the
+ * registers after it executed.
+ **/
+BOOST_FIXTURE_TEST_CASE(RecordInstructions, TracedProgram){
+    interpreter.run(3);
+
+    BOOST_TEST(trace.size() == 3);
+    TraceRecord record = trace.getRecord(1);
+    BOOST_TEST(record.PC == 0x202);
+    BOOST_TEST(record.opcode == 0x7A01);
+    BOOST_TEST(record.VX == 0x02);
+
+    record = trace.getRecord(2);
+    BOOST_TEST(record.I == 0x123);
+}
+
+/**
+ * Only the most recent records are held.
+ **/
+BOOST_FIXTURE_TEST_CASE(RingBufferWraps, TracedProgram){
+    interpreter.run(20);
+
+    BOOST_TEST(trace.size() == 8);
+    // 20 instructions: STRI, then 19 from the 3 instruction loop
+    BOOST_TEST(trace.getRecord(7).opcode == 0x7A01);
+    BOOST_TEST(trace.getRecord(0).opcode == 0x1202);
+}
+
+/**
+ * Flushed traces read back identically.
+ **/
+BOOST_FIXTURE_TEST_CASE(FlushAndRead, TracedProgram){
+    std::string path = "InstructionTracingTests.trace";
+    interpreter.run(5);
+    BOOST_TEST(trace.flush(path));
+
+    std::vector<TraceRecord> records;
+    BOOST_TEST(InstructionTrace::read(path, records));
+    BOOST_TEST(records.size() == 5);
+    BOOST_TEST(records[4].opcode == trace.getRecord(4).opcode);
+    BOOST_TEST(records[4].VX == trace.getRecord(4).VX);
+
+    std::remove(path.c_str());
+}
+
+/**
+ * An armed trigger flushes the trace once
+ * the matching instruction executes.
+ **/
+BOOST_FIXTURE_TEST_CASE(TriggerFlushes, TracedProgram){
+    std::string path = "InstructionTracingTests.trigger.trace";
+
+    // Trigger on the first JUMP, the fourth instruction
+    trace.armTrigger({0xFFFF, 0x206, 0xFFFF, 0x1202}, path);
+    interpreter.run(4);
+    BOOST_TEST(trace.hasTriggered());
+
+    interpreter.run(10);
+
+    std::vector<TraceRecord> records;
+    BOOST_TEST(InstructionTrace::read(path, records));
+    BOOST_TEST(records.size() == 4);
+    BOOST_TEST(records.back().opcode == 0x1202);
+
+    std::remove(path.c_str());
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -283,4 +283,40 @@ BOOST_FIXTURE_TEST_CASE(LDMTest1, Fixture){
 
 }
 
+/**
+ * STRM and LDM Instructions across pages
+ *
+ * This test checks the following:
+ * - Registers stored across the end of a page of
+ *   memory are split between both pages
+ * - They are loaded back from both pages
+ **/
+BOOST_FIXTURE_TEST_CASE(STRMLDMAcrossPagesTest, Fixture){
+    // STRM V7; LDM V7
+    interpreter.memory[0x200] = 0xF7;
+    interpreter.memory[0x201] = 0x55;
+    interpreter.memory[0x202] = 0xF7;
+    interpreter.memory[0x203] = 0x65;
+
+    for(uint8_t registerNum = 0; registerNum < 8; registerNum++){
+        interpreter.registers.V[registerNum] = 0x10 + registerNum;
+    }
+    interpreter.registers.I = 0x2FC;
+
+    // Tick the interpreter
+    interpreter.tick();
+
+    for(uint8_t registerNum = 0; registerNum < 8; registerNum++){
+        BOOST_TEST(interpreter.memory[0x2FC + registerNum] == 0x10 + registerNum);
+        interpreter.registers.V[registerNum] = 0x00;
+    }
+
+    // Tick the interpreter
+    interpreter.tick();
+
+    for(uint8_t registerNum = 0; registerNum < 8; registerNum++){
+        BOOST_TEST(interpreter.registers.V[registerNum] == 0x10 + registerNum);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END();
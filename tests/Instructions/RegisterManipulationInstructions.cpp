@@ -76,8 +76,8 @@ BOOST_DATA_TEST_CASE_F(Fixture, STRDTests, STRD_DATA, opcode, registerX, delayVa
     interpreter.memory[0x200] = (opcode & 0xFF00) >> 8;
     interpreter.memory[0x201] = (opcode & 0x00FF) >> 0;
 
-    // Set the delay register
-    interpreter.registers.DT = delayValue;
+    // Set the delay timer
+    interpreter.setDelayTimer(delayValue);
 
     // Tick the interpreter
     interpreter.tick();
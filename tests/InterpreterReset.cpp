@@ -0,0 +1,115 @@
+#include <boost/test/unit_test.hpp>
+
+#include <ChipM8/System/Interpreter.h>
+
+#include <memory>
+
+/**
+ * A program leaving state behind, then drawing random numbers
+ *
+ * 0x200 6A07   STRI VA, 0x07
+ * 0x202 FA15   SETD VA
+ * 0x204 D005   DRAW V0, V0, 5
+ * 0x206 A300   STR 0x300
+ * 0x208 FA55   STRM VA
+ * 0x20A 2210   EXE 0x210
+ * 0x20C C0FF   RND V0, 0xFF
+ * 0x20E 120C   JUMP 0x20C
+ * 0x210 C1FF   RND V1, 0xFF
+ * 0x212 00EE   RET
+ **/
+struct ResetProgram {
+    void setup(){
+        image = Interpreter::createImage(program, sizeof(program));
+    }
+
+    uint8_t program[20] = {
+        0x6A, 0x07, 0xFA, 0x15, 0xD0, 0x05, 0xA3, 0x00, 0xFA, 0x55,
+        0x22, 0x10, 0xC0, 0xFF, 0x12, 0x0C, 0xC1, 0xFF, 0x00, 0xEE
+    };
+    std::shared_ptr<const MemoryImage> image;
+    Interpreter interpreter;
+};
+
+/**
+ * Interpreter Reset Tests
+ *
+ * Tests reusing an Interpreter by resetting it to an image.
+ **/
+BOOST_AUTO_TEST_SUITE(InterpreterResetTests);
+
+/**
+ * The image holds the font and the program.
+ **/
+BOOST_FIXTURE_TEST_CASE(ImageHoldsFontAndProgram, ResetProgram){
+    Interpreter booted;
+    for(uint16_t address = 0; address < 0x200; address++){
+        BOOST_TEST(image->data[address] == booted.memory.read(address));
+    }
+    BOOST_TEST(image->data[0x00] == 0xF0);
+    BOOST_TEST(image->data[0x4F] == 0x80);
+    BOOST_TEST(image->data[0x200] == 0x6A);
+    BOOST_TEST(image->data[0x213] == 0xEE);
+    BOOST_TEST(image->data[0x214] == 0x00);
+}
+
+/**
+ * Resetting returns a used Interpreter to power on,
+ * sharing all of memory with the image.
+ **/
+BOOST_FIXTURE_TEST_CASE(ResetsToPowerOn, ResetProgram){
+    interpreter.reset(image, 1);
+    interpreter.input.setKeyPressed(0x3, true);
+    interpreter.run(100);
+    BOOST_TEST(interpreter.memory.getPrivatePageCount() > 0);
+    BOOST_TEST(interpreter.screen.getPixel(0, 0));
+    BOOST_TEST(interpreter.memory.read(0x30A) == 0x07);
+
+    interpreter.reset(image, 1);
+    BOOST_TEST(interpreter.registers.PC == 0x200);
+    BOOST_TEST(interpreter.registers.SP == 0x200);
+    BOOST_TEST(interpreter.registers.I == 0);
+    BOOST_TEST(interpreter.registers.V[0xA] == 0);
+    BOOST_TEST(interpreter.getDelayTimer() == 0);
+    BOOST_TEST(interpreter.getCycleCount() == 0);
+    BOOST_TEST(!interpreter.input.isKeyPressed(0x3));
+    BOOST_TEST(!interpreter.screen.getPixel(0, 0));
+    BOOST_TEST(interpreter.memory.getPrivatePageCount() == 0);
+    BOOST_TEST(interpreter.memory.read(0x30A) == 0);
+    BOOST_TEST(interpreter.memory.read(0x200) == 0x6A);
+}
+
+/**
+ * RND draws the same numbers from the same seed, and
+ * its generator is saved in snapshots.
+ **/
+BOOST_FIXTURE_TEST_CASE(SeedMakesRandomNumbersReproducible, ResetProgram){
+    Interpreter other;
+    interpreter.reset(image, 7);
+    other.reset(image, 7);
+    interpreter.run(20);
+    other.run(20);
+    BOOST_TEST(interpreter.registers.V[0] == other.registers.V[0]);
+    BOOST_TEST(interpreter.registers.V[1] == other.registers.V[1]);
+
+    Snapshot snapshot;
+    interpreter.saveSnapshot(snapshot);
+    interpreter.run(1);
+    uint8_t drawn = interpreter.registers.V[0];
+    interpreter.restoreSnapshot(snapshot);
+    interpreter.run(1);
+    BOOST_TEST(interpreter.registers.V[0] == drawn);
+
+    // Different seeds draw different sequences
+    other.reset(image, 8);
+    interpreter.reset(image, 7);
+    bool differs = false;
+    for(int draw = 0; draw < 8; draw++){
+        interpreter.run(2);
+        other.run(2);
+        differs |= interpreter.registers.V[0] != other.registers.V[0];
+    }
+    BOOST_TEST(differs);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
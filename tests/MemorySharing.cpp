@@ -0,0 +1,93 @@
+#include <boost/test/unit_test.hpp>
+
+#include <ChipM8/System/Interpreter.h>
+
+/**
+ * A ROM image shared by two Interpreters
+ *
+ * 0x200 A800   STR 0x800
+ * 0x202 6A7B   STRI VA, 0x7B
+ * 0x204 FA33   BCD VA
+ * 0x206 1206   JUMP 0x206
+ **/
+struct SharedProgram {
+    void setup(){
+        uint8_t program[] = {0xA8, 0x00, 0x6A, 0x7B, 0xFA, 0x33, 0x12, 0x06};
+        Interpreter loader;
+        loader.loadProgram(program, sizeof(program));
+        image = loader.memory.createImage();
+
+        first.memory.setImage(image);
+        second.memory.setImage(image);
+    }
+
+    std::shared_ptr<const MemoryImage> image;
+    Interpreter first;
+    Interpreter second;
+};
+
+/**
+ * Memory Sharing Tests
+ *
+ * Tests sharing the pages of memory images between
+ * Interpreters, and copying pages on their first write.
+ **/
+BOOST_AUTO_TEST_SUITE(MemorySharingTests);
+
+/**
+ * A new Interpreter shares the font rather than
+ * holding any memory of its own.
+ **/
+BOOST_AUTO_TEST_CASE(FontIsShared){
+    Interpreter interpreter;
+    BOOST_TEST(interpreter.memory.getPrivatePageCount() == 0);
+    BOOST_TEST(interpreter.memory.read(0x0000) == 0xF0);
+    BOOST_TEST(interpreter.memory.read(0x0005) == 0x20);
+}
+
+/**
+ * Only the page written to is copied, and the
+ * write is not seen by the other Interpreter.
+ **/
+BOOST_FIXTURE_TEST_CASE(CopyOnWrite, SharedProgram){
+    first.run(3);
+    BOOST_TEST(first.memory.getPrivatePageCount() == 1);
+    BOOST_TEST(first.memory.read(0x800) == 1);
+    BOOST_TEST(first.memory.read(0x802) == 3);
+    BOOST_TEST(first.memory.read(0x202) == 0x6A);
+
+    BOOST_TEST(second.memory.getPrivatePageCount() == 0);
+    BOOST_TEST(second.memory.read(0x800) == 0);
+    BOOST_TEST(image->data[0x800] == 0);
+}
+
+/**
+ * The index operator makes the page private, as
+ * it may be written through.
+ **/
+BOOST_FIXTURE_TEST_CASE(IndexOperatorCopies, SharedProgram){
+    first.memory[0x2FF] = 0x12;
+    BOOST_TEST(first.memory.getPrivatePageCount() == 1);
+    BOOST_TEST(first.memory.read(0x200) == 0xA8);
+    BOOST_TEST(first.memory.read(0x2FF) == 0x12);
+    BOOST_TEST(second.memory.read(0x2FF) == 0x00);
+}
+
+/**
+ * Restoring a snapshot shares the pages copied
+ * since it was saved again.
+ **/
+BOOST_FIXTURE_TEST_CASE(RestoreSharesPages, SharedProgram){
+    Snapshot pristine;
+    first.saveSnapshot(pristine);
+    BOOST_TEST(pristine.memory.pages.empty());
+
+    first.run(3);
+    BOOST_TEST(first.memory.getPrivatePageCount() == 1);
+
+    first.restoreSnapshot(pristine);
+    BOOST_TEST(first.memory.getPrivatePageCount() == 0);
+    BOOST_TEST(first.memory.read(0x800) == 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -0,0 +1,106 @@
+#include <boost/test/unit_test.hpp>
+
+#include <ChipM8/System/Interpreter.h>
+
+#include <cstring>
+
+/**
+ * Runs tests/Data/NativeTest.ch8 on two Interpreters, one of
+ * them with the ROM recompiled to native code
+ *
+ * The ROM calls an arithmetic subroutine in a counted loop,
+ * draws, overwrites its own code at 0x230, polls the delay
+ * timer and reaches 0x242 only through a computed jump.
+ **/
+struct NativeComparison {
+    void setup(){
+        BOOST_REQUIRE_MESSAGE(program.load(NATIVE_TEST_PROGRAM), program.getError());
+
+        native.loadProgram(NATIVE_TEST_ROM);
+        interpreted.loadProgram(NATIVE_TEST_ROM);
+        native.setCyclesPerTimerTick(20);
+        interpreted.setCyclesPerTimerTick(20);
+        native.setNativeProgram(&program);
+    }
+
+    /**
+     * Checks that both Interpreters are in the same state
+     **/
+    bool isIdentical(){
+        bool identical = std::memcmp(native.registers.V, interpreted.registers.V, 16) == 0 &&
+            native.registers.I == interpreted.registers.I &&
+            native.registers.PC == interpreted.registers.PC &&
+            native.registers.SP == interpreted.registers.SP &&
+            native.getCycleCount() == interpreted.getCycleCount() &&
+            native.getDelayTimer() == interpreted.getDelayTimer() &&
+            std::memcmp(native.memory.createImage()->data, interpreted.memory.createImage()->data, 0x10000) == 0;
+
+        for(uint8_t row = 0; row < 32; row++){
+            for(uint8_t col = 0; col < 64; col++){
+                identical = identical && native.screen.getPixel(row, col) == interpreted.screen.getPixel(row, col);
+            }
+        }
+        return identical;
+    }
+
+    NativeProgram program;
+    Interpreter native;
+    Interpreter interpreted;
+};
+
+/**
+ * Native Program Tests
+ *
+ * Tests running ROMs recompiled to native code.
+ **/
+BOOST_AUTO_TEST_SUITE(NativeProgramTests);
+
+/**
+ * A missing shared object fails to load.
+ **/
+BOOST_AUTO_TEST_CASE(LoadFailure){
+    NativeProgram program;
+    BOOST_TEST(!program.load("Missing.so"));
+    BOOST_TEST(!program.getError().empty());
+    BOOST_TEST(program.getBlockCount() == 0);
+}
+
+/**
+ * Native code has exactly the effect of interpreting the
+ * ROM, whatever the cycle budget of each run.
+ **/
+BOOST_FIXTURE_TEST_CASE(MatchesInterpreter, NativeComparison){
+    BOOST_TEST(program.getBlockCount() > 0);
+    BOOST_TEST(program.getBlock(0x200) != nullptr);
+    BOOST_TEST(program.getBlock(0x242) == nullptr);
+
+    for(std::size_t cycles = 1; cycles < 120; cycles += 7){
+        std::size_t nativeExecuted = native.run(cycles);
+        std::size_t interpretedExecuted = interpreted.run(cycles);
+        BOOST_TEST(nativeExecuted == interpretedExecuted);
+        BOOST_TEST(isIdentical());
+    }
+    // Instrumented builds only interpret
+#ifndef CHIPM8_INSTRUMENTATION
+    BOOST_TEST(native.getNativeInstructionCount() > 0);
+#endif
+}
+
+/**
+ * The block whose code was overwritten is interpreted.
+ **/
+BOOST_FIXTURE_TEST_CASE(ModifiedCodeIsInterpreted, NativeComparison){
+    const NativeBlock *block = program.getBlock(0x230);
+    BOOST_REQUIRE(block != nullptr);
+    BOOST_TEST(program.isUnmodified(*block, native.memory));
+
+    native.run(2000);
+    interpreted.run(2000);
+    BOOST_TEST(native.memory.read(0x231) == 0x99);
+    BOOST_TEST(!program.isUnmodified(*block, native.memory));
+    BOOST_TEST(native.registers.V[0xC] == 0x99);
+    BOOST_TEST(native.registers.V[0xD] > 0);
+    BOOST_TEST(isIdentical());
+}
+
+BOOST_AUTO_TEST_SUITE_END();
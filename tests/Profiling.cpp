@@ -0,0 +1,92 @@
+#include <boost/test/unit_test.hpp>
+
+#include <ChipM8/System/Interpreter.h>
+
+#include <sstream>
+#include <string>
+
+/**
+ * Program calling a subroutine twice
+ *
+ * 0x200 2206   EXE  0x206
+ * 0x202 2206   EXE  0x206
+ * 0x204 1204   JUMP 0x204
+ * 0x206 6A01   STRI VA, 0x01
+ * 0x208 00EE   RET
+ **/
+struct SubroutineProgram {
+    void setup(){
+        uint8_t program[] = {0x22, 0x06, 0x22, 0x06, 0x12, 0x04, 0x6A, 0x01, 0x00, 0xEE};
+        for(std::size_t byte = 0; byte < sizeof(program); byte++){
+            interpreter.memory[0x200 + byte] = program[byte];
+        }
+    }
+
+    Profiler profiler;
+    Interpreter interpreter;
+};
+
+/**
+ * Profiling Tests
+ *
+ * Tests attributing cycles to addresses
+ * and call stacks.
+ **/
+BOOST_AUTO_TEST_SUITE(ProfilingTests);
+
+/**
+ * Cycles are attributed to each address
+ * and to the frame they executed in.
+ **/
+BOOST_FIXTURE_TEST_CASE(AttributeCycles, SubroutineProgram){
+    interpreter.setProfiler(&profiler);
+    interpreter.run(9);
+
+    BOOST_TEST(profiler.getTotalCycles() == 9);
+    BOOST_TEST(profiler.getAddressCycles(0x204) == 3);
+    BOOST_TEST(profiler.getAddressCycles(0x206) == 2);
+
+    std::ostringstream stacks;
+    profiler.writeCollapsedStacks(stacks);
+    BOOST_TEST(stacks.str() == "0x200 5\n0x200;0x206 4\n");
+
+    std::ostringstream heat;
+    profiler.writeHeatTable(heat);
+    BOOST_TEST(heat.str().find("0x206,0x6A01,STRI VA, 0x01,2,22.222") != std::string::npos);
+}
+
+/**
+ * Attaching inside a subroutine reconstructs
+ * the call stack from the Chip8 stack.
+ **/
+BOOST_FIXTURE_TEST_CASE(ReconstructCallStack, SubroutineProgram){
+    interpreter.tick();
+    BOOST_TEST(interpreter.registers.PC == 0x206);
+
+    interpreter.setProfiler(&profiler);
+    interpreter.run(3);
+
+    std::ostringstream stacks;
+    profiler.writeCollapsedStacks(stacks);
+    BOOST_TEST(stacks.str() == "0x200 1\n0x200;0x206 2\n");
+}
+
+/**
+ * A breakpoint which does not stop on a call
+ * leaves the call stacks unchanged.
+ **/
+BOOST_FIXTURE_TEST_CASE(PassingBreakpointOnCall, SubroutineProgram){
+    interpreter.addBreakpoint(0x200, [](const Registers &){ return false; });
+    interpreter.setProfiler(&profiler);
+    interpreter.run(9);
+
+    std::ostringstream stacks;
+    profiler.writeCollapsedStacks(stacks);
+    BOOST_TEST(stacks.str() == "0x200 5\n0x200;0x206 4\n");
+
+    std::ostringstream heat;
+    profiler.writeHeatTable(heat);
+    BOOST_TEST(heat.str().find("0x200,0x2206,EXE 0x206") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
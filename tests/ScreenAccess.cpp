@@ -0,0 +1,92 @@
+#include <boost/test/unit_test.hpp>
+
+#include <ChipM8/Peripherals/Screen.h>
+
+#include <cstddef>
+
+/**
+ * A screen with a scattered pattern lit, touching
+ * the first and last column of the rows
+ **/
+struct PatternedScreen {
+    void setup(){
+        for(uint8_t row = 0; row < 32; row++){
+            for(uint8_t col = 0; col < 64; col++){
+                screen.setPixel(row, col, (row * 7 + col * 3) % 5 == 0 || col == row || col == 63);
+            }
+        }
+    }
+
+    Screen screen;
+};
+
+/**
+ * Screen Access Tests
+ *
+ * Tests reading whole frames from the screen.
+ **/
+BOOST_AUTO_TEST_SUITE(ScreenAccessTests);
+
+/**
+ * The pixel and row views read the pixels getPixel does.
+ **/
+BOOST_FIXTURE_TEST_CASE(ViewsMatchPixels, PatternedScreen){
+    const Screen &view = screen;
+    std::span<const bool, 32 * 64> pixels = view.getPixels();
+    bool matches = true;
+    for(uint8_t row = 0; row < 32; row++){
+        std::span<const bool, 64> pixelRow = view.getRow(row);
+        for(uint8_t col = 0; col < 64; col++){
+            matches &= pixels[row * 64 + col] == screen.getPixel(row, col);
+            matches &= pixelRow[col] == screen.getPixel(row, col);
+        }
+    }
+    BOOST_TEST(matches);
+
+    // The views follow later changes
+    screen.setPixel(3, 4, !screen.getPixel(3, 4));
+    BOOST_TEST(pixels[3 * 64 + 4] == screen.getPixel(3, 4));
+}
+
+/**
+ * Packed rows have column 0 in the most significant bit.
+ **/
+BOOST_FIXTURE_TEST_CASE(PacksRows, PatternedScreen){
+    uint64_t rows[32];
+    screen.packRows(rows);
+    for(uint8_t row = 0; row < 32; row++){
+        uint64_t expected = 0;
+        for(uint8_t col = 0; col < 64; col++){
+            expected = (expected << 1) | screen.getPixel(row, col);
+        }
+        BOOST_TEST(rows[row] == expected);
+    }
+
+    screen.clear();
+    screen.setPixel(0, 0, true);
+    screen.setPixel(31, 63, true);
+    screen.packRows(rows);
+    BOOST_TEST(rows[0] == 0x8000000000000000ULL);
+    BOOST_TEST(rows[31] == 1);
+    BOOST_TEST(rows[15] == 0);
+}
+
+/**
+ * Screens are equal when all their pixels are.
+ **/
+BOOST_FIXTURE_TEST_CASE(ComparesFrames, PatternedScreen){
+    Screen copy = screen;
+    BOOST_TEST((copy == screen));
+
+    copy.setPixel(17, 40, !copy.getPixel(17, 40));
+    BOOST_TEST(!(copy == screen));
+
+    copy.setPixel(17, 40, screen.getPixel(17, 40));
+    BOOST_TEST((copy == screen));
+
+    Screen blank;
+    screen.clear();
+    BOOST_TEST((blank == screen));
+}
+
+BOOST_AUTO_TEST_SUITE_END();
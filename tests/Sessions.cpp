@@ -0,0 +1,151 @@
+#include <boost/test/unit_test.hpp>
+
+#include <ChipM8/Async/Executor.h>
+
+#include <stdexcept>
+#include <vector>
+
+/**
+ * Runs a session until it has waited for
+ * a key, recording the frame results
+ **/
+Task waitForKey(Session &session, std::vector<FrameResult> &results){
+    FrameResult frame = co_await session.nextFrame();
+    results.push_back(frame);
+    if(frame.waiting){
+        results.push_back(co_await session.keyWait());
+    }
+}
+
+/**
+ * Runs frames until the sound timer stops
+ **/
+Task waitForSilence(Session &session, std::vector<FrameResult> &results){
+    results.push_back(co_await session.soundChange());
+}
+
+/**
+ * Throws after the first frame
+ **/
+Task failAfterFrame(Session &session){
+    co_await session.nextFrame();
+    throw std::runtime_error("failed");
+}
+
+/**
+ * Session Tests
+ *
+ * Tests running interpreters from coroutines.
+ **/
+BOOST_AUTO_TEST_SUITE(SessionTests);
+
+/**
+ * A coroutine suspends until a frame has run,
+ * and until a pending WAIT has been delivered.
+ *
+ * 0x200 F30A   WAIT V3
+ * 0x202 1202   JUMP 0x202
+ **/
+BOOST_AUTO_TEST_CASE(FrameAndKeyWait){
+    Interpreter interpreter;
+    uint8_t program[] = {0xF3, 0x0A, 0x12, 0x02};
+    interpreter.loadProgram(program, sizeof(program));
+
+    Executor executor;
+    Session session(interpreter, executor, 10);
+    std::vector<FrameResult> results;
+    executor.spawn(waitForKey(session, results));
+    BOOST_TEST(results.empty());
+
+    executor.runFrame();
+    BOOST_TEST(results.size() == 1);
+    BOOST_TEST(results[0].frames == 1);
+    BOOST_TEST(results[0].instructions == 1);
+    BOOST_TEST(results[0].waiting);
+
+    executor.runFrame();
+    executor.runFrame();
+    BOOST_TEST(results.size() == 1);
+
+    interpreter.input.setKeyPressed(0xB, true);
+    executor.runFrame();
+    BOOST_TEST(results.size() == 2);
+    BOOST_TEST(results[1].frames == 3);
+    BOOST_TEST(!results[1].waiting);
+    BOOST_TEST(interpreter.registers.V[3] == 0xB);
+    BOOST_TEST(executor.getTaskCount() == 0);
+}
+
+/**
+ * A coroutine suspends until the sound timer stops.
+ *
+ * 0x200 6A03   STRI VA, 0x03
+ * 0x202 FA18   SETS VA
+ * 0x204 1204   JUMP 0x204
+ **/
+BOOST_AUTO_TEST_CASE(SoundChange){
+    Interpreter interpreter;
+    uint8_t program[] = {0x6A, 0x03, 0xFA, 0x18, 0x12, 0x04};
+    interpreter.loadProgram(program, sizeof(program));
+    interpreter.run(2);
+
+    Executor executor;
+    Session session(interpreter, executor, 10);
+    std::vector<FrameResult> results;
+    executor.spawn(waitForSilence(session, results));
+
+    executor.runFrame();
+    executor.runFrame();
+    BOOST_TEST(results.empty());
+    executor.runFrame();
+    BOOST_TEST(results.size() == 1);
+    BOOST_TEST(results[0].frames == 3);
+    BOOST_TEST(!results[0].sounding);
+}
+
+/**
+ * Many sessions are multiplexed on one executor.
+ *
+ * 0x200 7001   ADDI V0, 0x01
+ * 0x202 1200   JUMP 0x200
+ **/
+BOOST_AUTO_TEST_CASE(ManySessions){
+    const std::size_t SESSIONS = 100;
+    std::vector<Interpreter> interpreters(SESSIONS);
+    std::vector<Session> sessions;
+    std::vector<std::vector<FrameResult>> results(SESSIONS);
+
+    Executor executor;
+    uint8_t program[] = {0x70, 0x01, 0x12, 0x00};
+    for(std::size_t session = 0; session < SESSIONS; session++){
+        interpreters[session].loadProgram(program, sizeof(program));
+        sessions.emplace_back(interpreters[session], executor, 20);
+    }
+    for(std::size_t session = 0; session < SESSIONS; session++){
+        executor.spawn(waitForKey(sessions[session], results[session]));
+    }
+    BOOST_TEST(executor.getTaskCount() == SESSIONS);
+
+    executor.runFrame();
+    BOOST_TEST(executor.getTaskCount() == 0);
+    for(std::size_t session = 0; session < SESSIONS; session++){
+        BOOST_TEST(results[session].size() == 1);
+        BOOST_TEST(interpreters[session].registers.V[0] == 10);
+    }
+}
+
+/**
+ * An exception escaping a coroutine is
+ * rethrown from the executor.
+ **/
+BOOST_AUTO_TEST_CASE(ExceptionPropagates){
+    Interpreter interpreter;
+    Executor executor;
+    Session session(interpreter, executor, 10);
+    executor.spawn(failAfterFrame(session));
+
+    BOOST_CHECK_THROW(executor.runFrame(), std::runtime_error);
+    BOOST_TEST(executor.getTaskCount() == 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -0,0 +1,118 @@
+#include <boost/test/unit_test.hpp>
+
+#include <ChipM8/System/Interpreter.h>
+
+#include <cstring>
+
+/**
+ * Interpreter with a snapshot saved before running
+ * a program that writes to memory and the screen
+ *
+ * 0x200 A300   STR 0x300
+ * 0x202 6A7B   STRI VA, 0x7B
+ * 0x204 FA33   BCD VA
+ * 0x206 D005   DRAW V0, V0, 0x5
+ * 0x208 2300   EXE 0x300
+ **/
+struct SnapshotProgram {
+    void setup(){
+        uint8_t program[] = {0xA3, 0x00, 0x6A, 0x7B, 0xFA, 0x33, 0xD0, 0x05, 0x23, 0x00};
+        interpreter.loadProgram(program, sizeof(program));
+        interpreter.saveSnapshot(pristine);
+        pristineImage = interpreter.memory.createImage();
+    }
+
+    /**
+     * Checks that the interpreter matches the pristine snapshot
+     **/
+    bool isPristine(){
+        return interpreter.registers.PC == 0x200 &&
+            interpreter.registers.SP == 0x200 &&
+            interpreter.registers.I == pristine.registers.I &&
+            interpreter.registers.V[0xA] == 0 &&
+            interpreter.getCycleCount() == 0 &&
+            !interpreter.screen.getPixel(0, 0) &&
+            std::memcmp(interpreter.memory.createImage()->data, pristineImage->data, 0x10000) == 0;
+    }
+
+    Interpreter interpreter;
+    Snapshot pristine;
+    std::shared_ptr<const MemoryImage> pristineImage;
+};
+
+/**
+ * Snapshot Tests
+ *
+ * Tests saving and restoring the machine state.
+ **/
+BOOST_AUTO_TEST_SUITE(SnapshotTests);
+
+/**
+ * Restoring undoes the writes to the registers,
+ * memory, stack and screen.
+ **/
+BOOST_FIXTURE_TEST_CASE(RestoreUndoesExecution, SnapshotProgram){
+    interpreter.run(5);
+    BOOST_TEST(interpreter.memory.read(0x301) == 2);
+    BOOST_TEST(interpreter.screen.getPixel(0, 7));
+    BOOST_TEST(interpreter.registers.SP == 0x1FE);
+
+    interpreter.restoreSnapshot(pristine);
+    BOOST_TEST(isPristine());
+}
+
+/**
+ * Restoring repeatedly, which only copies the pages
+ * written since, always leads back to the same state.
+ **/
+BOOST_FIXTURE_TEST_CASE(RepeatedRestores, SnapshotProgram){
+    for(int iteration = 0; iteration < 3; iteration++){
+        interpreter.run(5 + iteration);
+        interpreter.memory[0x800] = 0xAA;
+        interpreter.restoreSnapshot(pristine);
+        BOOST_TEST(isPristine());
+    }
+}
+
+/**
+ * Restoring a snapshot other than the last one
+ * saved copies back all of memory.
+ **/
+BOOST_FIXTURE_TEST_CASE(RestoreOlderSnapshot, SnapshotProgram){
+    interpreter.run(5);
+    Snapshot later;
+    interpreter.saveSnapshot(later);
+    BOOST_TEST(later.cycleCount == 5);
+
+    interpreter.restoreSnapshot(pristine);
+    BOOST_TEST(isPristine());
+
+    interpreter.restoreSnapshot(later);
+    BOOST_TEST(interpreter.getCycleCount() == 5);
+    BOOST_TEST(interpreter.memory.read(0x300) == 1);
+    BOOST_TEST(interpreter.registers.PC == 0x300);
+}
+
+/**
+ * A pending WAIT instruction is part of the
+ * snapshot and is delivered after restoring.
+ **/
+BOOST_AUTO_TEST_CASE(RestorePendingWait){
+    Interpreter interpreter;
+    uint8_t program[] = {0xF3, 0x0A};
+    interpreter.loadProgram(program, sizeof(program));
+    interpreter.tick();
+    BOOST_TEST(interpreter.hasExecutionHalted());
+
+    Snapshot waiting;
+    interpreter.saveSnapshot(waiting);
+    interpreter.input.setKeyPressed(0x7, true);
+    BOOST_TEST(!interpreter.hasExecutionHalted());
+
+    interpreter.restoreSnapshot(waiting);
+    BOOST_TEST(interpreter.hasExecutionHalted());
+    interpreter.input.setKeyPressed(0x9, true);
+    BOOST_TEST(interpreter.registers.V[3] == 0x9);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -0,0 +1,148 @@
+#include <boost/test/unit_test.hpp>
+
+#include <ChipM8/System/Interpreter.h>
+
+#include <vector>
+
+/**
+ * Interpreter running at 1000 cycles per second with
+ * a speaker producing one sample per cycle and a
+ * 250 Hz tone, so a period is exactly 4 samples.
+ *
+ * 0x200 6A05   STRI VA, 0x05
+ * 0x202 FA18   SETS VA
+ * 0x204 1204   JUMP 0x204
+ **/
+struct SoundProgram {
+    void setup(){
+        uint8_t program[] = {0x6A, 0x05, 0xFA, 0x18, 0x12, 0x04};
+        for(std::size_t byte = 0; byte < sizeof(program); byte++){
+            interpreter.memory[0x200 + byte] = program[byte];
+        }
+        interpreter.speaker.configure(1000, 250, 1000, 100);
+    }
+
+    Interpreter interpreter;
+};
+
+/**
+ * Sound Output Tests
+ *
+ * Tests the sample stream produced by the
+ * speaker from the sound timer.
+ **/
+BOOST_AUTO_TEST_SUITE(SoundOutputTests);
+
+/**
+ * An unconfigured speaker produces nothing
+ **/
+BOOST_AUTO_TEST_CASE(DisabledSpeaker){
+    Interpreter interpreter;
+    interpreter.run(10);
+    interpreter.tickTimers();
+
+    BOOST_TEST(!interpreter.speaker.isEnabled());
+    BOOST_TEST(interpreter.speaker.availableSamples() == 0);
+}
+
+/**
+ * The tone starts on the sample of the cycle in
+ * which SETS executed and stops on the sample of
+ * the cycle in which the sound timer ran out.
+ **/
+BOOST_FIXTURE_TEST_CASE(ToneIsSampleAccurate, SoundProgram){
+    interpreter.run(20);
+    interpreter.tickTimers();
+
+    // SETS ran on cycle 1, so samples 1 to 19 hold the tone
+    std::vector<int16_t> samples(64);
+    BOOST_TEST(interpreter.speaker.readSamples(samples.data(), samples.size()) == 20);
+    BOOST_TEST(samples[0] == 0);
+    BOOST_TEST(samples[1] == 100);
+    BOOST_TEST(samples[2] == 100);
+    BOOST_TEST(samples[3] == -100);
+    BOOST_TEST(samples[4] == -100);
+    BOOST_TEST(samples[5] == 100);
+
+    // Run out the sound timer part way through the next batch
+    interpreter.run(10);
+    for(int tick = 0; tick < 4; tick++){
+        interpreter.tickTimers();
+    }
+    interpreter.run(10);
+    interpreter.tickTimers();
+
+    BOOST_TEST(interpreter.registers.ST == 0);
+    BOOST_TEST(interpreter.speaker.readSamples(samples.data(), samples.size()) == 20);
+    BOOST_TEST(samples[9] != 0);
+    for(std::size_t sample = 10; sample < 20; sample++){
+        BOOST_TEST(samples[sample] == 0);
+    }
+}
+
+/**
+ * Samples which do not fit into the ring buffer
+ * are dropped rather than overwriting unread ones.
+ **/
+BOOST_FIXTURE_TEST_CASE(FullBufferDropsSamples, SoundProgram){
+    interpreter.run(Speaker::BUFFER_SIZE + 100);
+    interpreter.tickTimers();
+
+    BOOST_TEST(interpreter.speaker.availableSamples() == Speaker::BUFFER_SIZE);
+    BOOST_TEST(interpreter.speaker.droppedSamples() == 100);
+}
+
+/**
+ * Resetting the Interpreter restarts the sample
+ * timeline, so the next run produces samples
+ * straight away rather than after the old
+ * cycle count is reached again.
+ **/
+BOOST_FIXTURE_TEST_CASE(ResetRestartsSamples, SoundProgram){
+    interpreter.run(100);
+    interpreter.tickTimers();
+
+    std::vector<int16_t> samples(128);
+    BOOST_TEST(interpreter.speaker.readSamples(samples.data(), samples.size()) == 100);
+
+    uint8_t program[] = {0x6A, 0x05, 0xFA, 0x18, 0x12, 0x04};
+    interpreter.reset(Interpreter::createImage(program, sizeof(program)), 1);
+    interpreter.run(20);
+    interpreter.tickTimers();
+
+    BOOST_TEST(interpreter.speaker.readSamples(samples.data(), samples.size()) == 20);
+    BOOST_TEST(samples[0] == 0);
+    BOOST_TEST(samples[1] == 100);
+}
+
+/**
+ * Restoring a snapshot continues the sample
+ * stream from the restored cycle with the tone
+ * of the restored sound timer.
+ **/
+BOOST_FIXTURE_TEST_CASE(RestoreResumesTone, SoundProgram){
+    Snapshot snapshot;
+    interpreter.run(4);
+    interpreter.saveSnapshot(snapshot);
+
+    // Run past the end of the tone
+    interpreter.run(100);
+    for(int tick = 0; tick < 6; tick++){
+        interpreter.tickTimers();
+    }
+    BOOST_TEST(interpreter.registers.ST == 0);
+
+    std::vector<int16_t> samples(128);
+    interpreter.speaker.readSamples(samples.data(), samples.size());
+
+    interpreter.restoreSnapshot(snapshot);
+    interpreter.run(10);
+    interpreter.tickTimers();
+
+    BOOST_TEST(interpreter.speaker.readSamples(samples.data(), samples.size()) == 10);
+    for(std::size_t sample = 0; sample < 10; sample++){
+        BOOST_TEST(samples[sample] != 0);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END();
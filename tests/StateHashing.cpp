@@ -0,0 +1,169 @@
+#include <boost/test/unit_test.hpp>
+
+#include <ChipM8/System/Interpreter.h>
+
+#include <random>
+#include <vector>
+
+/**
+ * A program writing memory and drawing each frame
+ *
+ * 0x200 A300   STR 0x300
+ * 0x202 F033   BCD V0
+ * 0x204 D015   DRAW V0, V1, 5
+ * 0x206 7003   ADDI V0, 0x03
+ * 0x208 2210   EXE 0x210
+ * 0x20A 1202   JUMP 0x202
+ * 0x210 F155   STRM V1
+ * 0x212 00EE   RET
+ **/
+struct HashedProgram {
+    void setup(){
+        uint8_t program[] = {
+            0xA3, 0x00, 0xF0, 0x33, 0xD0, 0x15, 0x70, 0x03, 0x22, 0x10, 0x12, 0x02, 0x00, 0x00, 0x00, 0x00,
+            0xF1, 0x55, 0x00, 0xEE
+        };
+        interpreter.loadProgram(program, sizeof(program));
+        interpreter.setStateHashing(true);
+    }
+
+    Interpreter interpreter;
+};
+
+/**
+ * State Hashing Tests
+ *
+ * Tests the incrementally maintained hash of the
+ * machine state.
+ **/
+BOOST_AUTO_TEST_SUITE(StateHashingTests);
+
+/**
+ * The tracked hash matches the hash computed from
+ * scratch as memory and the screen are written.
+ **/
+BOOST_FIXTURE_TEST_CASE(TrackedHashMatches, HashedProgram){
+    interpreter.setHashValidation(true);
+    for(int frame = 0; frame < 20; frame++){
+        interpreter.run(37);
+        interpreter.hash();
+    }
+    BOOST_TEST(interpreter.getHashMismatchCount() == 0);
+    BOOST_TEST(interpreter.memory.computeHash() == interpreter.memory.getHash());
+    BOOST_TEST(interpreter.screen.computeHash() == interpreter.screen.getHash());
+}
+
+/**
+ * The hash changes with the state and does not depend
+ * on whether memory is hashed incrementally.
+ **/
+BOOST_FIXTURE_TEST_CASE(HashFollowsState, HashedProgram){
+    uint64_t initial = interpreter.hash();
+    interpreter.run(10);
+    uint64_t later = interpreter.hash();
+    BOOST_TEST(initial != later);
+
+    interpreter.setStateHashing(false);
+    BOOST_TEST(interpreter.hash() == later);
+
+    interpreter.registers.V[5] ^= 1;
+    BOOST_TEST(interpreter.hash() != later);
+}
+
+/**
+ * Host writes through the index operator are hashed
+ * when the hash is next read.
+ **/
+BOOST_FIXTURE_TEST_CASE(HostWritesAreHashed, HashedProgram){
+    uint64_t before = interpreter.memory.getHash();
+    interpreter.memory[0x900] = 0x42;
+    BOOST_TEST(interpreter.memory.getHash() != before);
+    BOOST_TEST(interpreter.memory.getHash() == interpreter.memory.computeHash());
+
+    interpreter.memory[0x900] = 0x00;
+    BOOST_TEST(interpreter.memory.getHash() == before);
+}
+
+/**
+ * Restoring a snapshot restores the hash, and the same
+ * state reached twice has the same hash.
+ **/
+BOOST_FIXTURE_TEST_CASE(SnapshotRestoresHash, HashedProgram){
+    Snapshot snapshot;
+    interpreter.run(5);
+    interpreter.saveSnapshot(snapshot);
+    uint64_t saved = interpreter.hash();
+
+    interpreter.run(50);
+    uint64_t reached = interpreter.hash();
+    BOOST_TEST(reached != saved);
+
+    interpreter.restoreSnapshot(snapshot);
+    BOOST_TEST(interpreter.hash() == saved);
+    BOOST_TEST(interpreter.hash() == interpreter.computeHash());
+
+    interpreter.run(50);
+    BOOST_TEST(interpreter.hash() == reached);
+}
+
+/**
+ * The cycles owed by the last instruction and left
+ * to wait for the display are hashed, the latter
+ * relative to the cycle count.
+ **/
+BOOST_FIXTURE_TEST_CASE(PendingCyclesAreHashed, HashedProgram){
+    Snapshot snapshot;
+    interpreter.run(5);
+    interpreter.saveSnapshot(snapshot);
+    uint64_t saved = interpreter.hash();
+
+    Snapshot owing = snapshot;
+    owing.cycleOvershoot = 3;
+    interpreter.restoreSnapshot(owing);
+    BOOST_TEST(interpreter.hash() != saved);
+
+    Snapshot waiting = snapshot;
+    waiting.displayWaitCycle = snapshot.cycleCount + 10;
+    interpreter.restoreSnapshot(waiting);
+    uint64_t waited = interpreter.hash();
+    BOOST_TEST(waited != saved);
+
+    waiting.cycleCount += 100;
+    waiting.displayWaitCycle += 100;
+    interpreter.restoreSnapshot(waiting);
+    BOOST_TEST(interpreter.hash() == waited);
+
+    interpreter.restoreSnapshot(snapshot);
+    BOOST_TEST(interpreter.hash() == saved);
+}
+
+/**
+ * Random programs keep the tracked hash in step with
+ * the hash computed from scratch.
+ **/
+BOOST_AUTO_TEST_CASE(RandomPrograms){
+    std::mt19937 generator(2);
+
+    for(int programNumber = 0; programNumber < 20; programNumber++){
+        std::vector<uint8_t> program(64);
+        for(uint8_t &byte : program){
+            byte = generator() & 0xFF;
+        }
+
+        Interpreter interpreter;
+        interpreter.loadProgram(program.data(), program.size());
+        interpreter.setStateHashing(true);
+        interpreter.setHashValidation(true);
+        for(int frame = 0; frame < 10; frame++){
+            interpreter.run(1 + generator() % 100);
+            interpreter.tickTimers();
+            interpreter.hash();
+            if(interpreter.hasExecutionHalted()){
+                interpreter.input.setKeyPressed(0x1, true);
+            }
+        }
+        BOOST_TEST(interpreter.getHashMismatchCount() == 0);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END();
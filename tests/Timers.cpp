@@ -0,0 +1,158 @@
+#include <boost/test/unit_test.hpp>
+
+#include <ChipM8/System/Interpreter.h>
+
+#include <vector>
+
+/**
+ * Interpreter whose timers tick once every 100 cycles
+ *
+ * 0x200 6A05   STRI VA, 0x05
+ * 0x202 FA15   SETD VA
+ * 0x204 FA18   SETS VA
+ * 0x206 FB07   STRD VB
+ * 0x208 1206   JUMP 0x206
+ **/
+struct TimerProgram {
+    void setup(){
+        uint8_t program[] = {0x6A, 0x05, 0xFA, 0x15, 0xFA, 0x18, 0xFB, 0x07, 0x12, 0x06};
+        for(std::size_t byte = 0; byte < sizeof(program); byte++){
+            interpreter.memory[0x200 + byte] = program[byte];
+        }
+        interpreter.setCyclesPerTimerTick(100);
+    }
+
+    Interpreter interpreter;
+};
+
+/**
+ * Timer Tests
+ *
+ * Tests the delay and sound timers, both when
+ * driven by the host and when derived from
+ * the cycle count.
+ **/
+BOOST_AUTO_TEST_SUITE(TimerTests);
+
+/**
+ * Host driven timers count down once
+ * per call to tickTimers.
+ **/
+BOOST_AUTO_TEST_CASE(HostDrivenTimers){
+    Interpreter interpreter;
+    interpreter.setDelayTimer(3);
+    interpreter.setSoundTimer(1);
+
+    interpreter.tickTimers();
+    BOOST_TEST(interpreter.registers.DT == 2);
+    BOOST_TEST(interpreter.registers.ST == 0);
+
+    interpreter.tickTimers();
+    interpreter.tickTimers();
+    interpreter.tickTimers();
+    BOOST_TEST(interpreter.getDelayTimer() == 0);
+}
+
+/**
+ * Cycle derived timers count down with
+ * the cycles executed, and STRD reads
+ * the materialized value.
+ **/
+BOOST_FIXTURE_TEST_CASE(CycleDerivedTimers, TimerProgram){
+    interpreter.run(250);
+    BOOST_TEST(interpreter.getDelayTimer() == 3);
+    BOOST_TEST(interpreter.getSoundTimer() == 3);
+    BOOST_TEST(interpreter.registers.V[0xB] == 3);
+
+    // Calling tickTimers does not tick them a second time
+    interpreter.tickTimers();
+    BOOST_TEST(interpreter.getDelayTimer() == 3);
+
+    interpreter.run(260);
+    BOOST_TEST(interpreter.getDelayTimer() == 0);
+    BOOST_TEST(interpreter.registers.V[0xB] == 0);
+}
+
+/**
+ * Setting a timer to the value it last showed
+ * restarts it, even though it expired since.
+ **/
+BOOST_AUTO_TEST_CASE(SettingTheLastShownValueRestarts){
+    Interpreter interpreter;
+    interpreter.setCyclesPerTimerTick(10);
+    interpreter.setDelayTimer(5);
+    interpreter.setSoundTimer(5);
+    BOOST_TEST(interpreter.getDelayTimer() == 5);
+    BOOST_TEST(interpreter.getSoundTimer() == 5);
+
+    // Both expire without being read
+    interpreter.run(100);
+    interpreter.setDelayTimer(5);
+    interpreter.setSoundTimer(5);
+    BOOST_TEST(interpreter.getDelayTimer() == 5);
+    BOOST_TEST(interpreter.getSoundTimer() == 5);
+
+    // The registers only mirror the timers
+    interpreter.registers.DT = 9;
+    BOOST_TEST(interpreter.getDelayTimer() == 5);
+}
+
+/**
+ * The state of the Interpreter does not depend
+ * on how the cycles were batched.
+ **/
+BOOST_FIXTURE_TEST_CASE(TimersAreDeterministic, TimerProgram){
+    Interpreter batched;
+    for(uint16_t address = 0x200; address < 0x20A; address++){
+        batched.memory[address] = interpreter.memory[address];
+    }
+    batched.setCyclesPerTimerTick(100);
+
+    interpreter.run(437);
+    for(int batch = 0; batch < 19; batch++){
+        batched.run(23);
+    }
+
+    BOOST_TEST(interpreter.getCycleCount() == batched.getCycleCount());
+    BOOST_TEST(interpreter.getDelayTimer() == batched.getDelayTimer());
+    BOOST_TEST(interpreter.registers.V[0xB] == batched.registers.V[0xB]);
+    BOOST_TEST(interpreter.registers.PC == batched.registers.PC);
+}
+
+/**
+ * Cycle derived timers keep running while
+ * the Interpreter is halted.
+ **/
+BOOST_AUTO_TEST_CASE(TimersRunWhileHalted){
+    Interpreter interpreter;
+    interpreter.memory[0x200] = 0xF0;
+    interpreter.memory[0x201] = 0x0A;
+    interpreter.setCyclesPerTimerTick(10);
+    interpreter.setDelayTimer(4);
+
+    interpreter.run(25);
+    BOOST_TEST(interpreter.hasExecutionHalted());
+    BOOST_TEST(interpreter.getCycleCount() == 25);
+    BOOST_TEST(interpreter.getDelayTimer() == 2);
+}
+
+/**
+ * With cycle derived timers the tone stops on
+ * the exact sample at which the sound timer
+ * expires.
+ **/
+BOOST_FIXTURE_TEST_CASE(ToneEndsOnExpiry, TimerProgram){
+    interpreter.speaker.configure(1000, 250, 1000, 100);
+
+    // SETS ran on cycle 2 with 5 ticks, expiring on cycle 500
+    interpreter.run(600);
+
+    std::vector<int16_t> samples(600);
+    BOOST_TEST(interpreter.speaker.readSamples(samples.data(), samples.size()) == 600);
+    BOOST_TEST(samples[1] == 0);
+    BOOST_TEST(samples[2] != 0);
+    BOOST_TEST(samples[499] != 0);
+    BOOST_TEST(samples[500] == 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -0,0 +1,161 @@
+#include <boost/test/unit_test.hpp>
+
+#include <ChipM8/Async/VecEnv.h>
+
+#include <vector>
+
+/**
+ * A program scoring the iterations key 5 is held, and
+ * drawing the last digit of the score
+ *
+ * 0x200 6005   STRI V0, 0x05
+ * 0x202 E0A1   SNP V0
+ * 0x204 7101   ADDI V1, 0x01
+ * 0x206 A300   STR 0x300
+ * 0x208 F133   BCD V1
+ * 0x20A 00E0   CLS
+ * 0x20C F129   NUM V1
+ * 0x20E 6208   STRI V2, 0x08
+ * 0x210 D225   DRAW V2, V2, 5
+ * 0x212 1202   JUMP 0x202
+ **/
+struct ScoringProgram {
+    void setup(){
+        uint8_t program[] = {
+            0x60, 0x05, 0xE0, 0xA1, 0x71, 0x01, 0xA3, 0x00, 0xF1, 0x33,
+            0x00, 0xE0, 0xF1, 0x29, 0x62, 0x08, 0xD2, 0x25, 0x12, 0x02
+        };
+        interpreter.loadProgram(program, sizeof(program));
+        interpreter.saveSnapshot(initial);
+    }
+
+    /**
+     * Steps a single Interpreter the way the VecEnv steps
+     * an environment
+     **/
+    void stepSequentially(bool held){
+        interpreter.input.setKeyPressed(0x5, held);
+        for(uint32_t frame = 0; frame < FRAMES_PER_STEP; frame++){
+            interpreter.run(CYCLES_PER_FRAME);
+            interpreter.tickTimers();
+        }
+    }
+
+    // 10 iterations a frame with key 5 held
+    static const uint32_t CYCLES_PER_FRAME = 90;
+    static const uint32_t FRAMES_PER_STEP = 2;
+
+    Interpreter interpreter;
+    Snapshot initial;
+};
+
+/**
+ * VecEnv Tests
+ *
+ * Tests stepping a batch of environments and collecting
+ * their screens and rewards.
+ **/
+BOOST_AUTO_TEST_SUITE(VecEnvTests);
+
+/**
+ * Every environment's screen and reward match stepping
+ * an Interpreter with the same keys on its own.
+ **/
+BOOST_FIXTURE_TEST_CASE(StepsMatchSequentialRuns, ScoringProgram){
+    const std::size_t ENVIRONMENTS = 5;
+    VecEnv env(initial, ENVIRONMENTS, CYCLES_PER_FRAME, FRAMES_PER_STEP, 3);
+    env.addReward(0x300, 1.0f, 3, RewardEncoding::BCD);
+
+    std::vector<uint16_t> actions(ENVIRONMENTS);
+    std::vector<uint8_t> observations(ENVIRONMENTS * 32 * 64);
+    std::vector<uint64_t> packed(ENVIRONMENTS * 32);
+    std::vector<float> rewards(ENVIRONMENTS);
+    std::vector<std::vector<bool>> held(ENVIRONMENTS);
+    for(std::size_t step = 0; step < 4; step++){
+        for(std::size_t environment = 0; environment < ENVIRONMENTS; environment++){
+            held[environment].push_back((step + environment) % 3 != 0);
+            actions[environment] = held[environment].back()? 1 << 0x5: 0;
+        }
+        if(step % 2 == 0){
+            env.step(actions.data(), observations.data(), rewards.data());
+            env.observePacked(packed.data());
+        }else{
+            env.stepPacked(actions.data(), packed.data(), rewards.data());
+            env.observe(observations.data());
+        }
+
+        for(std::size_t environment = 0; environment < ENVIRONMENTS; environment++){
+            interpreter.restoreSnapshot(initial);
+            for(bool keyHeld : held[environment]){
+                stepSequentially(keyHeld);
+            }
+
+            BOOST_TEST(rewards[environment] == (held[environment].back()? 20.0f: 0.0f));
+            BOOST_TEST(env.getInterpreter(environment).registers.V[1] == interpreter.registers.V[1]);
+            bool matches = true;
+            for(uint8_t row = 0; row < 32; row++){
+                for(uint8_t col = 0; col < 64; col++){
+                    bool lit = interpreter.screen.getPixel(row, col);
+                    matches &= observations[(environment * 32 + row) * 64 + col] == lit;
+                    matches &= ((packed[environment * 32 + row] >> (63 - col)) & 1) == lit;
+                }
+            }
+            BOOST_TEST(matches);
+        }
+    }
+}
+
+/**
+ * Rewards of all the sources are scaled and summed.
+ **/
+BOOST_FIXTURE_TEST_CASE(RewardsAreScaledAndSummed, ScoringProgram){
+    VecEnv env(initial, 2, CYCLES_PER_FRAME, FRAMES_PER_STEP, 2);
+    env.addReward(0x300, 0.5f, 3, RewardEncoding::BCD);
+    // The ones digit alone
+    env.addReward(0x302, 2.0f);
+
+    uint16_t actions[] = {1 << 0x5, 0};
+    float rewards[2];
+    env.step(actions, nullptr, rewards);
+
+    // 20 iterations, leaving the ones digit at 0
+    BOOST_TEST(rewards[0] == 10.0f);
+    BOOST_TEST(rewards[1] == 0.0f);
+
+    env.setFramesPerStep(1);
+    env.step(actions, nullptr, rewards);
+    BOOST_TEST(rewards[0] == 5.0f);
+    BOOST_TEST(env.getInterpreter(0).registers.V[1] == 30);
+
+    env.clearRewards();
+    env.step(actions, nullptr, rewards);
+    BOOST_TEST(rewards[0] == 0.0f);
+}
+
+/**
+ * A reset environment starts over from the initial
+ * snapshot with no keys held, leaving the others alone.
+ **/
+BOOST_FIXTURE_TEST_CASE(ResetRestoresInitialState, ScoringProgram){
+    VecEnv env(initial, 2, CYCLES_PER_FRAME, FRAMES_PER_STEP, 2);
+    env.addReward(0x300, 1.0f, 3, RewardEncoding::BCD);
+
+    uint16_t actions[] = {1 << 0x5, 1 << 0x5};
+    float rewards[2];
+    env.step(actions, nullptr, rewards);
+    env.step(actions, nullptr, rewards);
+
+    env.reset(0);
+    BOOST_TEST(env.getInterpreter(0).registers.V[1] == 0);
+    BOOST_TEST(!env.getInterpreter(0).input.isKeyPressed(0x5));
+    BOOST_TEST(env.getInterpreter(1).registers.V[1] == 40);
+
+    // The score dropping back to 0 is not paid out
+    env.step(actions, nullptr, rewards);
+    BOOST_TEST(rewards[0] == 20.0f);
+    BOOST_TEST(rewards[1] == 20.0f);
+    BOOST_TEST(env.getEnvironmentCount() == 2);
+    BOOST_TEST(env.getThreadCount() == 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
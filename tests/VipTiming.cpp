@@ -0,0 +1,124 @@
+#include <boost/test/unit_test.hpp>
+
+#include <ChipM8/System/Interpreter.h>
+
+/**
+ * Loops of ALU instructions and of unaligned draws
+ *
+ * 0x200 7001   ADDI V0, 0x01
+ * 0x202 8100   COPY V1, V0
+ * 0x204 1200   JUMP 0x200
+ *
+ * 0x206 6303   STRI V3, 0x03
+ * 0x208 D335   DRAW V3, V3, 5
+ * 0x20A 1208   JUMP 0x208
+ **/
+struct TimedProgram {
+    void setup(){
+        uint8_t program[] = {
+            0x70, 0x01, 0x81, 0x00, 0x12, 0x00,
+            0x63, 0x03, 0xD3, 0x35, 0x12, 0x08
+        };
+        interpreter.loadProgram(program, sizeof(program));
+        interpreter.setTimingModel(TimingModel::VIP);
+    }
+
+    Interpreter interpreter;
+};
+
+/**
+ * VIP Timing Tests
+ *
+ * Tests timing instructions in COSMAC VIP machine cycles.
+ **/
+BOOST_AUTO_TEST_SUITE(VipTimingTests);
+
+/**
+ * DRAW costs more per row, and more when the sprite
+ * is not byte aligned.
+ **/
+BOOST_AUTO_TEST_CASE(DrawCostDependsOnRowsAndAlignment){
+    Registers registers{};
+    registers.V[0] = 8;
+    registers.V[1] = 3;
+    registers.V[2] = 1;
+
+    uint32_t aligned = getVipCycles(0xD005, registers);
+    BOOST_TEST(getVipCycles(0xD00A, registers) > aligned);
+    BOOST_TEST(getVipCycles(0xD105, registers) > aligned);
+    BOOST_TEST(getVipCycles(0xD105, registers) > 10 * getVipCycles(0x7001, registers));
+
+    // BCD and STRM depend on their operands
+    BOOST_TEST(getVipCycles(0xF133, registers) > getVipCycles(0xF233, registers));
+    BOOST_TEST(getVipCycles(0xFF55, registers) > getVipCycles(0xF055, registers));
+}
+
+/**
+ * The cycle count advances by each instruction's
+ * machine cycles.
+ **/
+BOOST_FIXTURE_TEST_CASE(CountsMachineCycles, TimedProgram){
+    uint32_t iteration = getVipCycles(0x7001, interpreter.registers)
+        + getVipCycles(0x8100, interpreter.registers)
+        + getVipCycles(0x1200, interpreter.registers);
+
+    BOOST_TEST(interpreter.run(iteration * 10) == 30);
+    BOOST_TEST(interpreter.getCycleCount() == iteration * 10);
+    BOOST_TEST(interpreter.registers.V[0] == 10);
+}
+
+/**
+ * Cycles the last instruction of a run overshoots
+ * are taken from the next run.
+ **/
+BOOST_FIXTURE_TEST_CASE(OvershootCarriesOver, TimedProgram){
+    interpreter.registers.PC = 0x206;
+
+    uint64_t instructions = 0;
+    for(uint32_t frame = 1; frame <= 10; frame++){
+        instructions += interpreter.run(VIP_CYCLES_PER_FRAME);
+        uint64_t budget = (uint64_t) frame * VIP_CYCLES_PER_FRAME;
+        BOOST_TEST(interpreter.getCycleCount() >= budget);
+        BOOST_TEST(interpreter.getCycleCount() < budget + getVipCycles(0xD335, interpreter.registers));
+    }
+
+    // An unaligned 5 row DRAW takes about 200 machine cycles
+    BOOST_TEST(instructions > 10 * VIP_CYCLES_PER_FRAME / 250);
+    BOOST_TEST(instructions < 10 * VIP_CYCLES_PER_FRAME / 100);
+}
+
+/**
+ * ALU code executes many more instructions per frame
+ * than DRAW heavy code, without fusion.
+ **/
+BOOST_FIXTURE_TEST_CASE(DrawHeavyCodeRunsSlower, TimedProgram){
+    interpreter.setFusion(true);
+    std::size_t alu = interpreter.run(VIP_CYCLES_PER_FRAME);
+    interpreter.registers.PC = 0x206;
+    std::size_t draw = interpreter.run(VIP_CYCLES_PER_FRAME);
+
+    BOOST_TEST(alu > 4 * draw);
+    BOOST_TEST(interpreter.getFusionCount(Fusion::CountedLoop) == 0);
+
+    interpreter.setTimingModel(TimingModel::Instruction);
+    BOOST_TEST(interpreter.run(100) == 100);
+}
+
+/**
+ * A breakpoint's trap is timed as the instruction
+ * it replaced.
+ **/
+BOOST_FIXTURE_TEST_CASE(TrapsKeepTiming, TimedProgram){
+    Interpreter reference;
+    uint8_t program[] = {0x70, 0x01, 0x81, 0x00, 0x12, 0x00};
+    reference.loadProgram(program, sizeof(program));
+    reference.setTimingModel(TimingModel::VIP);
+    reference.run(500);
+
+    interpreter.addBreakpoint(0x202, [](const Registers &registers){ return registers.V[0] == 100; });
+    interpreter.run(500);
+    BOOST_TEST(interpreter.getCycleCount() == reference.getCycleCount());
+    BOOST_TEST(interpreter.registers.V[0] == reference.registers.V[0]);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -0,0 +1,137 @@
+#include <boost/test/unit_test.hpp>
+
+#include <ChipM8/System/Interpreter.h>
+
+/**
+ * A program writing and reading back 0x300 - 0x302
+ *
+ * 0x200 A300   STR 0x300
+ * 0x202 6A7B   STRI VA, 0x7B
+ * 0x204 FA33   BCD VA
+ * 0x206 F265   LDM V2
+ * 0x208 1208   JUMP 0x208
+ **/
+struct WatchedProgram {
+    void setup(){
+        uint8_t program[] = {0xA3, 0x00, 0x6A, 0x7B, 0xFA, 0x33, 0xF2, 0x65, 0x12, 0x08};
+        interpreter.loadProgram(program, sizeof(program));
+    }
+
+    Interpreter interpreter;
+};
+
+/**
+ * Watchpoint Tests
+ *
+ * Tests stopping run on accesses to watched addresses.
+ **/
+BOOST_AUTO_TEST_SUITE(WatchpointTests);
+
+/**
+ * A write to a watched address stops run after the
+ * writing instruction, leaving the cycles unspent.
+ **/
+BOOST_FIXTURE_TEST_CASE(WriteStopsRun, WatchedProgram){
+    interpreter.memory.addWatchpoint(0x301, Watch::Write);
+
+    BOOST_TEST(interpreter.run(100) == 3);
+    BOOST_TEST((interpreter.getStopReason() == StopReason::Watchpoint));
+    BOOST_TEST(interpreter.getCycleCount() == 3);
+    BOOST_TEST(interpreter.registers.PC == 0x206);
+
+    WatchHit hit = interpreter.getWatchHit();
+    BOOST_TEST(hit.pc == 0x204);
+    BOOST_TEST(hit.address == 0x301);
+    BOOST_TEST((hit.access == Watch::Write));
+    BOOST_TEST(hit.value == 2);
+
+    // The instruction completes
+    BOOST_TEST(interpreter.memory.read(0x302) == 3);
+}
+
+/**
+ * A read of a watched address by LDM stops run.
+ **/
+BOOST_FIXTURE_TEST_CASE(ReadStopsRun, WatchedProgram){
+    interpreter.memory.addWatchpoint(0x302, Watch::Read);
+
+    BOOST_TEST(interpreter.run(100) == 4);
+    BOOST_TEST((interpreter.getStopReason() == StopReason::Watchpoint));
+
+    WatchHit hit = interpreter.getWatchHit();
+    BOOST_TEST(hit.pc == 0x206);
+    BOOST_TEST(hit.address == 0x302);
+    BOOST_TEST((hit.access == Watch::Read));
+    BOOST_TEST(hit.value == 3);
+    BOOST_TEST(interpreter.registers.V[2] == 3);
+}
+
+/**
+ * Accesses to unwatched addresses of a watched page,
+ * and instruction fetches, do not stop run.
+ **/
+BOOST_FIXTURE_TEST_CASE(UnwatchedAccessesRun, WatchedProgram){
+    interpreter.memory.addWatchpoint(0x303, Watch::Access);
+    interpreter.memory.addWatchpoint(0x204, Watch::Read);
+
+    BOOST_TEST(interpreter.run(100) == 100);
+    BOOST_TEST((interpreter.getStopReason() == StopReason::None));
+    BOOST_TEST(interpreter.getCycleCount() == 100);
+}
+
+/**
+ * Running again continues from the next instruction
+ * and stops on the next watched access.
+ **/
+BOOST_FIXTURE_TEST_CASE(RunContinues, WatchedProgram){
+    interpreter.memory.addWatchpoint(0x300, Watch::Access);
+
+    interpreter.run(100);
+    BOOST_TEST((interpreter.getWatchHit().access == Watch::Write));
+
+    interpreter.run(100);
+    BOOST_TEST((interpreter.getStopReason() == StopReason::Watchpoint));
+    BOOST_TEST((interpreter.getWatchHit().access == Watch::Read));
+    BOOST_TEST(interpreter.getWatchHit().pc == 0x206);
+
+    interpreter.run(100);
+    BOOST_TEST((interpreter.getStopReason() == StopReason::None));
+    BOOST_TEST(interpreter.getCycleCount() == 104);
+}
+
+/**
+ * Removing the watchpoint restores the fast path for
+ * writes to the page.
+ **/
+BOOST_FIXTURE_TEST_CASE(RemovedWatchpointRuns, WatchedProgram){
+    interpreter.memory.addWatchpoint(0x301, Watch::Write);
+    interpreter.memory.removeWatchpoint(0x301);
+    BOOST_TEST(!interpreter.memory.hasWatchpoints());
+
+    BOOST_TEST(interpreter.run(100) == 100);
+    BOOST_TEST((interpreter.getStopReason() == StopReason::None));
+    BOOST_TEST(interpreter.registers.V[1] == 2);
+}
+
+/**
+ * A watched page shared with another Interpreter is
+ * still copied on write.
+ **/
+BOOST_FIXTURE_TEST_CASE(WatchedPageIsCopied, WatchedProgram){
+    Interpreter other;
+    other.memory.setImage(interpreter.memory.createImage());
+    other.memory.addWatchpoint(0x300, Watch::Write);
+
+    other.run(100);
+    BOOST_TEST((other.getStopReason() == StopReason::Watchpoint));
+    BOOST_TEST(other.memory.read(0x300) == 1);
+    BOOST_TEST(interpreter.memory.read(0x300) == 0);
+
+    // Private pages still divert watched writes
+    other.registers.PC = 0x204;
+    other.run(100);
+    BOOST_TEST(other.getWatchHit().pc == 0x204);
+    BOOST_TEST(other.getCycleCount() == 4);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -0,0 +1,42 @@
+#include <ChipM8/Analysis/Recompiler.h>
+
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+/**
+ * Recompiler
+ *
+ * Recompiles a ROM ahead of time to C++ source, which is compiled
+ * into a shared object and loaded with NativeProgram.
+ *
+ * Usage: Recompiler <rom> <output source>
+ **/
+int main(int argc, char *argv[]){
+    if(argc != 3){
+        std::cerr << "Usage: " << argv[0] << " <rom> <output source>" << std::endl;
+        return 1;
+    }
+
+    std::ifstream romFile(argv[1], std::ios_base::binary);
+    if(!romFile.good()){
+        std::cerr << "Could not read ROM " << argv[1] << std::endl;
+        return 1;
+    }
+    std::vector<uint8_t> rom((std::istreambuf_iterator<char>(romFile)), std::istreambuf_iterator<char>());
+
+    std::string path = argv[1];
+    std::size_t separator = path.find_last_of("/\\");
+    std::string name = (separator == std::string::npos)? path: path.substr(separator + 1);
+
+    std::ofstream source(argv[2]);
+    std::size_t blocks = writeNativeSource(rom.data(), rom.size(), name, source);
+    if(!source.good()){
+        std::cerr << "Could not write " << argv[2] << std::endl;
+        return 1;
+    }
+
+    std::cout << "Recompiled " << blocks << " blocks of " << name << " to " << argv[2] << std::endl;
+    return 0;
+}
@@ -0,0 +1,39 @@
+#include <ChipM8/System/Instruction.h>
+#include <ChipM8/System/InstructionTrace.h>
+
+#include <iostream>
+#include <vector>
+
+#include <stdio.h>
+
+/**
+ * Trace Decoder
+ *
+ * Decodes a trace flushed by InstructionTrace and prints
+ * one disassembled instruction per line, oldest first.
+ *
+ * Usage: TraceDecoder <trace file>
+ **/
+int main(int argc, char *argv[]){
+    if(argc != 2){
+        std::cerr << "Usage: " << argv[0] << " <trace file>" << std::endl;
+        return 1;
+    }
+
+    std::vector<TraceRecord> records;
+    if(!InstructionTrace::read(argv[1], records)){
+        std::cerr << "Could not read trace file " << argv[1] << std::endl;
+        return 1;
+    }
+
+    for(std::size_t index = 0; index < records.size(); index++){
+        const TraceRecord &record = records[index];
+        unsigned registerX = (record.opcode & 0x0F00) >> 8;
+
+        printf("%8zu  %03X  %04X  %-18s I=%03X V%X=%02X VF=%02X\n",
+            index, record.PC, record.opcode, disassembleInstruction(record.opcode).c_str(),
+            record.I, registerX, record.VX, record.VF);
+    }
+
+    return 0;
+}